@@ -0,0 +1,208 @@
+/**================================================================================
+* FILE: aa55_framer_bench.cpp
+
+* Purpose:
+* 1. Build a synthetic AA55 stream with garbage runs and corrupted frames
+* 2. Push it through Aa55Framer split into tiny, TCP-sized and coalesced
+*    chunks and check every frame and counter against what was generated
+* 3. Report GB/s and frames/s per chunking on one core
+
+* Usage: aa55_framer_bench
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "aa55_codec.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace embedded_test;
+
+struct Chunking {
+    const char* name;
+    size_t minimum;
+    size_t maximum;
+};
+
+static const Chunking kChunkings[] = {
+    {"1-64 B", 1, 64},
+    {"1-4096 B", 1, 4096},
+    {"64 KB", 65536, 65536},
+    {"1 MB", 1048576, 1048576},
+};
+
+static const size_t kStreamBytes = 64 * 1048576;
+static const int kRuns = 4;
+
+struct SyntheticStream {
+    std::vector<uint8_t> bytes;
+    std::vector<size_t> frame_offsets;  // good frames, in order
+    uint64_t garbage_bytes;
+    uint64_t garbage_runs;
+    uint64_t corrupted;
+};
+
+// Mostly back-to-back frames of 0-1500 byte payloads; now and then a run
+// of noise (without 0xAA) or a frame with a broken checksum, both of which
+// the framer has to skip
+static SyntheticStream make_stream(size_t target, std::mt19937& rng) {
+    SyntheticStream stream;
+    stream.garbage_bytes = 0;
+    stream.garbage_runs = 0;
+    stream.corrupted = 0;
+    stream.bytes.reserve(target + 70000);
+
+    std::vector<uint8_t> payload;
+    uint16_t sequence = 0;
+    bool last_was_garbage = false;
+
+    while (stream.bytes.size() < target) {
+        unsigned roll = rng() % 100;
+        if (roll < 2) {
+            size_t count = 1 + rng() % 300;
+            for (size_t i = 0; i < count; i++) {
+                uint8_t byte = static_cast<uint8_t>(rng());
+                stream.bytes.push_back(byte == 0xAA ? 0x00 : byte);
+            }
+            stream.garbage_bytes += count;
+            stream.garbage_runs += last_was_garbage ? 0 : 1;
+            last_was_garbage = true;
+            continue;
+        }
+
+        payload.resize(rng() % 1501);
+        for (uint8_t& byte : payload) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        std::vector<uint8_t> frame = Aa55Codec::build(static_cast<uint8_t>(rng()),
+                                                      ByteSpan(payload), sequence++);
+        if (roll < 3) {
+            frame.back() ^= 0x01;
+            stream.garbage_bytes += frame.size();
+            stream.garbage_runs += last_was_garbage ? 0 : 1;
+            stream.corrupted++;
+            last_was_garbage = true;
+        } else {
+            stream.frame_offsets.push_back(stream.bytes.size());
+            last_was_garbage = false;
+        }
+        stream.bytes.insert(stream.bytes.end(), frame.begin(), frame.end());
+    }
+    return stream;
+}
+
+static std::vector<size_t> make_cuts(size_t size, const Chunking& chunking, std::mt19937& rng) {
+    std::vector<size_t> cuts;
+    size_t pos = 0;
+    while (pos < size) {
+        size_t span = chunking.maximum - chunking.minimum + 1;
+        pos = std::min(size, pos + chunking.minimum + rng() % span);
+        cuts.push_back(pos);
+    }
+    return cuts;
+}
+
+static bool verify(const SyntheticStream& stream, const std::vector<size_t>& cuts,
+                   const char* name) {
+    Aa55Framer framer;
+    std::vector<Aa55View> frames;
+    size_t next = 0;
+    size_t start = 0;
+
+    for (size_t cut : cuts) {
+        frames.clear();
+        framer.push(ByteSpan(stream.bytes.data() + start, cut - start), frames);
+        start = cut;
+
+        for (const Aa55View& view : frames) {
+            if (next >= stream.frame_offsets.size()) {
+                std::printf("  %s: extra frame\n", name);
+                return false;
+            }
+            const uint8_t* expected = stream.bytes.data() + stream.frame_offsets[next];
+            if (!view.checksum_valid ||
+                view.size != Aa55Codec::frame_size(view.length, true) ||
+                std::memcmp(view.frame, expected, view.size) != 0) {
+                std::printf("  %s: frame %zu does not match\n", name, next);
+                return false;
+            }
+            next++;
+        }
+    }
+
+    const FramerStats& stats = framer.get_statistics();
+    if (next != stream.frame_offsets.size() || stats.frames != next ||
+        stats.bytes_in != stream.bytes.size() || framer.buffered() != 0 ||
+        stats.garbage_bytes != stream.garbage_bytes || stats.resyncs != stream.garbage_runs ||
+        stats.checksum_failures < stream.corrupted) {
+        std::printf("  %s: %zu/%zu frames, garbage %llu/%llu, resyncs %llu/%llu, "
+                    "checksum failures %llu (>= %llu)\n",
+                    name, next, stream.frame_offsets.size(),
+                    static_cast<unsigned long long>(stats.garbage_bytes),
+                    static_cast<unsigned long long>(stream.garbage_bytes),
+                    static_cast<unsigned long long>(stats.resyncs),
+                    static_cast<unsigned long long>(stream.garbage_runs),
+                    static_cast<unsigned long long>(stats.checksum_failures),
+                    static_cast<unsigned long long>(stream.corrupted));
+        return false;
+    }
+    return true;
+}
+
+static double measure(const SyntheticStream& stream, const std::vector<size_t>& cuts) {
+    Aa55Framer framer;
+    std::vector<Aa55View> frames;
+    frames.reserve(65536);
+    volatile size_t sink = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int run = 0; run < kRuns; run++) {
+        size_t start = 0;
+        for (size_t cut : cuts) {
+            frames.clear();
+            framer.push(ByteSpan(stream.bytes.data() + start, cut - start), frames);
+            sink = sink + frames.size();
+            start = cut;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    (void)sink;
+
+    return std::chrono::duration<double>(end - begin).count() / kRuns;
+}
+
+int main() {
+    std::mt19937 rng(42);
+    SyntheticStream stream = make_stream(kStreamBytes, rng);
+
+    std::printf("AA55 stream framer benchmark\n");
+    std::printf("  %.1f MB stream, %zu frames, %llu corrupted, %llu garbage bytes in %llu runs\n",
+                stream.bytes.size() / 1048576.0, stream.frame_offsets.size(),
+                static_cast<unsigned long long>(stream.corrupted),
+                static_cast<unsigned long long>(stream.garbage_bytes),
+                static_cast<unsigned long long>(stream.garbage_runs));
+
+    std::vector<std::vector<size_t>> cuts;
+    for (const Chunking& chunking : kChunkings) {
+        cuts.push_back(make_cuts(stream.bytes.size(), chunking, rng));
+        if (!verify(stream, cuts.back(), chunking.name)) {
+            return 1;
+        }
+    }
+    std::printf("  every chunking yields the generated frames and garbage counts\n\n");
+
+    std::printf("  %-10s %10s %10s %12s\n", "chunks", "pushes", "GB/s", "Mframes/s");
+    for (size_t i = 0; i < cuts.size(); i++) {
+        double seconds = measure(stream, cuts[i]);
+        std::printf("  %-10s %10zu %10.2f %12.2f\n", kChunkings[i].name, cuts[i].size(),
+                    stream.bytes.size() / seconds / 1e9,
+                    stream.frame_offsets.size() / seconds / 1e6);
+    }
+    return 0;
+}
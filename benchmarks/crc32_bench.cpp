@@ -0,0 +1,179 @@
+/**================================================================================
+* FILE: crc32_bench.cpp
+
+* Purpose:
+* 1. Check every CRC-32 path against the bitwise reference
+* 2. Report GB/s per path for buffers from 64 B to 1 MB
+* 3. Check crc32_combine and report threaded throughput on a 64 MB buffer
+
+* Usage: crc32_bench
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "crc32.h"
+#include "fast_comms.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace embedded_test;
+
+static const Crc32Path kPaths[] = {
+    Crc32Path::BITWISE,
+    Crc32Path::SLICE_BY_8,
+    Crc32Path::SLICE_BY_16,
+    Crc32Path::PCLMUL,
+    Crc32Path::AUTO
+};
+
+static const size_t kSizes[] = {
+    64, 256, 1024, 4096, 16384, 65536, 262144, 1048576
+};
+
+// Bytes hashed per measurement, so small sizes are not all loop overhead
+static const size_t kBytesPerRun = 256 * 1024 * 1024;
+
+// Random lengths and misalignments, plus split updates, against the reference
+static bool verify(const std::vector<uint8_t>& data) {
+    std::mt19937 rng(1);
+    for (int trial = 0; trial < 2000; trial++) {
+        size_t offset = rng() % 64;
+        size_t length = trial < 300 ? static_cast<size_t>(trial) : rng() % 5000;
+        const uint8_t* p = data.data() + offset;
+        uint32_t expected = crc32_update(0, p, length, Crc32Path::BITWISE);
+
+        for (Crc32Path path : kPaths) {
+            if (!crc32_path_available(path)) {
+                continue;
+            }
+            size_t split = length > 0 ? rng() % length : 0;
+            uint32_t whole = crc32_update(0, p, length, path);
+            uint32_t parts = crc32_update(crc32_update(0, p, split, path), p + split,
+                                          length - split, path);
+            if (whole != expected || parts != expected) {
+                std::printf("  MISMATCH %s: length %zu offset %zu: %08x/%08x, expected %08x\n",
+                            crc32_path_name(path), length, offset, whole, parts, expected);
+                return false;
+            }
+        }
+    }
+
+    // Standard check value
+    const uint8_t digits[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    uint32_t check = PacketValidator::calculate_crc32(ByteSpan(digits, sizeof(digits)));
+    if (check != 0xCBF43926) {
+        std::printf("  MISMATCH check value: %08x, expected cbf43926\n", check);
+        return false;
+    }
+    return true;
+}
+
+// Streams over random splits and threaded runs against one pass
+static bool verify_combine(const std::vector<uint8_t>& data) {
+    std::mt19937 rng(2);
+    for (int trial = 0; trial < 200; trial++) {
+        size_t length = rng() % data.size();
+        uint32_t expected = crc32_update(0, data.data(), length);
+
+        Crc32Stream first;
+        Crc32Stream second;
+        size_t split = length > 0 ? rng() % length : 0;
+        first.update(data.data(), split);
+        second.update(data.data() + split, length - split);
+        first.append(second);
+
+        uint32_t threaded = crc32_parallel(0, data.data(), length, 1 + rng() % 8);
+        if (first.finalize() != expected || first.length() != length || threaded != expected) {
+            std::printf("  MISMATCH combine: length %zu split %zu: %08x/%08x, expected %08x\n",
+                        length, split, first.finalize(), threaded, expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+static double measure(Crc32Path path, const uint8_t* data, size_t size) {
+    // The bitwise path is two orders slower; keep its runs short
+    size_t budget = path == Crc32Path::BITWISE ? kBytesPerRun / 64 : kBytesPerRun;
+    size_t iterations = budget / size > 0 ? budget / size : 1;
+    volatile uint32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t crc = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        crc = crc32_update(crc, data, size, path);
+    }
+    auto end = std::chrono::steady_clock::now();
+    sink = crc;
+    (void)sink;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(iterations) * size / seconds / 1e9;
+}
+
+int main() {
+    std::vector<uint8_t> data(1048576 + 64);
+    std::mt19937 rng(42);
+    for (uint8_t& byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    std::printf("CRC-32 benchmark\n");
+    if (!verify(data)) {
+        return 1;
+    }
+    std::printf("  all paths match the bitwise reference\n");
+
+    std::vector<uint8_t> large(64 * 1048576);
+    for (size_t i = 0; i < large.size(); i += 4) {
+        uint32_t word = rng();
+        std::memcpy(&large[i], &word, sizeof(word));
+    }
+    if (!verify_combine(large)) {
+        return 1;
+    }
+    std::printf("  streams, crc32_combine and threaded runs match one pass\n\n");
+
+    std::printf("  %-10s", "size");
+    for (Crc32Path path : kPaths) {
+        std::printf(" %12s", crc32_path_name(path));
+    }
+    std::printf("   (GB/s)\n");
+
+    for (size_t size : kSizes) {
+        if (size >= 1048576) {
+            std::printf("  %6zu MB ", size / 1048576);
+        } else if (size >= 1024) {
+            std::printf("  %6zu KB ", size / 1024);
+        } else {
+            std::printf("  %6zu B  ", size);
+        }
+        for (Crc32Path path : kPaths) {
+            if (!crc32_path_available(path)) {
+                std::printf(" %12s", "n/a");
+                continue;
+            }
+            std::printf(" %12.2f", measure(path, data.data(), size));
+        }
+        std::printf("\n");
+    }
+
+    unsigned cpus = std::max(1U, std::thread::hardware_concurrency());
+    std::printf("\n  crc32_parallel, 64 MB (%u CPUs)\n", cpus);
+    for (unsigned threads = 1; threads <= std::max(cpus, 4U); threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        volatile uint32_t crc = crc32_parallel(0, large.data(), large.size(), threads);
+        (void)crc;
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::printf("  %2u threads %10.2f GB/s\n", threads, large.size() / seconds / 1e9);
+    }
+    return 0;
+}
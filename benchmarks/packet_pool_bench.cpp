@@ -0,0 +1,142 @@
+/**================================================================================
+* FILE: packet_pool_bench.cpp
+
+* Purpose:
+* 1. Count heap allocations per million packets on the C++ data path
+* 2. Compare std::vector buffers with PacketPool buffers
+
+* Usage: packet_pool_bench [interface]   (default: lo, needs CAP_NET_RAW)
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "fast_comms.h"
+#include "packet_pool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+// Every operator new in the process goes through here
+static std::atomic<uint64_t> g_allocations(0);
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size > 0 ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+using namespace embedded_test;
+
+static const size_t kFrameSize = 1500;
+static const size_t kMemoryPackets = 1000000;
+static const size_t kSocketPackets = 100000;
+
+struct Measurement {
+    uint64_t allocations;
+    double elapsed_ns;
+};
+
+template <typename Body>
+static Measurement measure(size_t packets, Body body) {
+    uint64_t before = g_allocations.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < packets; i++) {
+        body(i);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    Measurement result;
+    result.allocations = g_allocations.load() - before;
+    result.elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return result;
+}
+
+static void report(const char* name, size_t packets, const Measurement& m) {
+    double per_million = static_cast<double>(m.allocations) * 1000000.0 / packets;
+    std::printf("  %-28s %12.0f allocs/M  %8.1f ns/pkt\n", name, per_million,
+                m.elapsed_ns / packets);
+}
+
+int main(int argc, char** argv) {
+    std::string interface_name = argc > 1 ? argv[1] : "lo";
+    volatile uint32_t sink = 0;
+
+    std::printf("PacketPool benchmark (%zu-byte frames)\n", kFrameSize);
+
+    // Memory path: build a frame, hand a second reference to a consumer, free
+    Measurement vectors = measure(kMemoryPackets, [&](size_t i) {
+        std::vector<uint8_t> frame(kFrameSize);
+        frame[0] = static_cast<uint8_t>(i);
+        std::vector<uint8_t> copy = frame;
+        sink = sink + copy[0];
+    });
+    report("vector per packet", kMemoryPackets, vectors);
+
+    PacketPool pool(kFrameSize, 256, 4);
+    pool.reserve(256);
+
+    Measurement pooled = measure(kMemoryPackets, [&](size_t i) {
+        PacketBuffer frame = pool.acquire();
+        frame.data()[0] = static_cast<uint8_t>(i);
+        frame.set_size(kFrameSize);
+        PacketBuffer shared = frame;
+        sink = sink + shared.data()[0];
+    });
+    report("pool acquire/share/release", kMemoryPackets, pooled);
+
+    // Socket path: send a frame and read one back through FastComms
+    FastComms comms(interface_name, 100);
+    if (!comms.initialize()) {
+        std::printf("  (skipping socket path: cannot open %s)\n", interface_name.c_str());
+        return 0;
+    }
+
+    std::vector<uint8_t> request(kFrameSize, 0xAB);
+    std::memset(request.data(), 0xFF, 12);
+
+    Measurement vector_rx = measure(kSocketPackets, [&](size_t) {
+        std::vector<uint8_t> response;
+        comms.send_packet(request);
+        comms.receive_packet(response);
+        sink = sink + static_cast<uint32_t>(response.size());
+    });
+    report("send + receive (vector)", kSocketPackets, vector_rx);
+
+    PacketBuffer tx = pool.acquire();
+    std::memcpy(tx.data(), request.data(), kFrameSize);
+    tx.set_size(kFrameSize);
+
+    Measurement pool_rx = measure(kSocketPackets, [&](size_t) {
+        PacketBuffer response = pool.acquire();
+        comms.send_packet(tx);
+        comms.receive_packet(response);
+        sink = sink + static_cast<uint32_t>(response.size());
+    });
+    report("send + receive (pool)", kSocketPackets, pool_rx);
+
+    PoolStats stats = pool.get_statistics();
+    std::printf("  pool: %llu slabs, %llu buffers, %llu exhausted\n",
+                static_cast<unsigned long long>(stats.slabs),
+                static_cast<unsigned long long>(stats.capacity),
+                static_cast<unsigned long long>(stats.exhausted));
+
+    return 0;
+}
@@ -21,6 +21,20 @@ ext_modules = [
         "fast_comms_cpp",
         sources=[
             "src/cpp/fast_comms.cpp",
+            "src/cpp/packet_ring.cpp",
+            "src/cpp/xdp_socket.cpp",
+            "src/cpp/io_uring_engine.cpp",
+            "src/cpp/comms_reactor.cpp",
+            "src/cpp/packet_pool.cpp",
+            "src/cpp/packet_filter.cpp",
+            "src/cpp/fanout_group.cpp",
+            "src/cpp/traffic_generator.cpp",
+            "src/cpp/latency_histogram.cpp",
+            "src/cpp/pcapng_writer.cpp",
+            "src/cpp/pcap_replay.cpp",
+            "src/cpp/crc32.cpp",
+            "src/cpp/inet_checksum.cpp",
+            "src/cpp/aa55_codec.cpp",
             "src/cpp/bindings.cpp",
         ],
         include_dirs=["src/cpp"],
@@ -0,0 +1,318 @@
+/**================================================================================
+* FILE: aa55_codec.cpp
+
+* Purpose:
+* 1. Implementation of the AA55 frame codec and stream framer
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "aa55_codec.h"
+#include "inet_checksum.h"
+#include <algorithm>
+#include <cstring>
+
+namespace embedded_test {
+
+// Exposed to Python as a structured array; keep the layout fixed
+static_assert(sizeof(Aa55Record) == 32, "Aa55Record must stay 32 bytes without padding");
+
+static inline uint16_t read16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+static inline void write16(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value >> 8);
+    p[1] = static_cast<uint8_t>(value);
+}
+
+size_t Aa55Codec::build_into(uint8_t* out, uint8_t command, uint16_t sequence,
+                             ByteSpan payload, bool include_checksum) {
+    write16(out, kMarker);
+    out[2] = command;
+    write16(out + 3, sequence);
+    write16(out + 5, static_cast<uint16_t>(payload.size()));
+    if (payload.size() > 0) {
+        memcpy(out + kHeaderSize, payload.data(), payload.size());
+    }
+
+    size_t size = kHeaderSize + payload.size();
+    if (include_checksum) {
+        write16(out + size, inet_checksum(out, size));
+        size += kChecksumSize;
+    }
+    return size;
+}
+
+std::vector<uint8_t> Aa55Codec::build(uint8_t command, ByteSpan payload, uint16_t sequence,
+                                      bool include_checksum) {
+    std::vector<uint8_t> frame(frame_size(payload.size(), include_checksum));
+    build_into(frame.data(), command, sequence, payload, include_checksum);
+    return frame;
+}
+
+bool Aa55Codec::parse(ByteSpan data, Aa55View& view) {
+    if (data.size() < kMinimumSize || read16(data.data()) != kMarker) {
+        return false;
+    }
+
+    const uint8_t* p = data.data();
+    view.frame = p;
+    view.size = data.size();
+    view.command = p[2];
+    view.sequence = read16(p + 3);
+    view.length = read16(p + 5);
+    view.payload = p + kHeaderSize;
+
+    // Like data[7:7+length]: whatever is there
+    size_t available = data.size() - kHeaderSize;
+    view.payload_size = view.length < available ? view.length : available;
+
+    size_t body = kHeaderSize + view.length;
+    view.has_checksum = data.size() >= body + kChecksumSize;
+    if (view.has_checksum) {
+        view.checksum = read16(p + body);
+        view.calculated_checksum = inet_checksum(p, body);
+        view.checksum_valid = view.checksum == view.calculated_checksum;
+    } else {
+        view.checksum = 0;
+        view.calculated_checksum = 0;
+        view.checksum_valid = false;
+    }
+    return true;
+}
+
+void Aa55Codec::build_batch(const uint8_t* commands, const uint16_t* sequences,
+                            const std::vector<ByteSpan>& payloads, bool include_checksum,
+                            Aa55FrameBatch& batch) {
+    size_t count = payloads.size();
+    size_t total = 0;
+    for (const ByteSpan& payload : payloads) {
+        total += frame_size(payload.size(), include_checksum);
+    }
+
+    batch.buffer.resize(total);
+    batch.offsets.resize(count);
+    batch.lengths.resize(count);
+
+    uint8_t* out = batch.buffer.data();
+    uint64_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t size = build_into(out + offset, commands[i], sequences[i], payloads[i],
+                                 include_checksum);
+        batch.offsets[i] = offset;
+        batch.lengths[i] = static_cast<uint32_t>(size);
+        offset += size;
+    }
+}
+
+void Aa55Codec::parse_batch(ByteSpan buffer, const uint64_t* offsets, const uint32_t* lengths,
+                            size_t count, Aa55ParseResult& result) {
+    result.records.resize(count);
+    result.valid = 0;
+    result.checksum_failures = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        Aa55Record& record = result.records[i];
+        memset(&record, 0, sizeof(record));
+        record.offset = offsets[i];
+
+        Aa55View view;
+        if (offsets[i] > buffer.size() || lengths[i] > buffer.size() - offsets[i] ||
+            !parse(ByteSpan(buffer.data() + offsets[i], lengths[i]), view)) {
+            continue;
+        }
+
+        record.payload_offset = offsets[i] + kHeaderSize;
+        record.payload_size = static_cast<uint32_t>(view.payload_size);
+        record.sequence = view.sequence;
+        record.length = view.length;
+        record.checksum = view.checksum;
+        record.calculated_checksum = view.calculated_checksum;
+        record.command = view.command;
+        record.valid = true;
+        record.has_checksum = view.has_checksum;
+        record.checksum_valid = view.checksum_valid;
+
+        result.valid++;
+        if (view.has_checksum && !view.checksum_valid) {
+            result.checksum_failures++;
+        }
+    }
+}
+
+void Aa55Codec::parse_batch(const Aa55FrameBatch& batch, Aa55ParseResult& result) {
+    parse_batch(ByteSpan(batch.buffer), batch.offsets.data(), batch.lengths.data(),
+                batch.count(), result);
+}
+
+// Aa55Framer Implementation
+
+Aa55Framer::Aa55Framer(const FramerConfig& config)
+    : config_(config),
+      spent_count_(0),
+      in_sync_(true) {
+}
+
+size_t Aa55Framer::push(ByteSpan chunk, std::vector<Aa55View>& frames) {
+    size_t before = frames.size();
+    const uint8_t* data = chunk.data();
+    size_t size = chunk.size();
+    size_t pos = 0;
+
+    size_t borrowed = 0;            // bytes of this chunk at the end of pending_
+
+    stats_.bytes_in += size;
+    spent_count_ = 0;
+
+    // Finish the frame an earlier chunk started, copying only what it needs
+    while (!pending_.empty()) {
+        size_t total = 0;
+        Candidate state = examine(pending_.data(), pending_.size(), total);
+
+        if (state == Candidate::NEED_MORE) {
+            size_t need = pending_.size() < 2 ? 2
+                        : pending_.size() < Aa55Codec::kHeaderSize ? Aa55Codec::kHeaderSize : total;
+            size_t take = std::min(need - pending_.size(), size - pos);
+            if (take == 0) {
+                return frames.size() - before;
+            }
+            pending_.insert(pending_.end(), data + pos, data + pos + take);
+            pos += take;
+            borrowed += take;
+            continue;
+        }
+
+        if (state == Candidate::FRAME && accept(pending_.data(), total, frames)) {
+            // Retire the buffer the view points into; anything carried past
+            // the frame (only after a resync) is framed again
+            if (spent_count_ == spent_.size()) {
+                spent_.emplace_back();
+            }
+            std::vector<uint8_t>& retired = spent_[spent_count_++];
+            retired.swap(pending_);
+            pending_.assign(retired.begin() + total, retired.end());
+            borrowed = 0;
+            continue;
+        }
+
+        // False marker: hand the borrowed bytes back to the chunk and look
+        // for the next marker in what was carried over
+        pending_.resize(pending_.size() - borrowed);
+        pos -= borrowed;
+        borrowed = 0;
+        size_t carried = pending_.size();
+        size_t skip = 1;
+        while (skip < carried) {
+            if (pending_[skip] == 0xAA) {
+                bool next_is_55 = skip + 1 < carried ? pending_[skip + 1] == 0x55
+                                                     : (pos == size || data[pos] == 0x55);
+                if (next_is_55) {
+                    break;
+                }
+            }
+            skip++;
+        }
+        discard(skip);
+        pending_.erase(pending_.begin(), pending_.begin() + skip);
+    }
+
+    // Everything else is framed in place
+    while (pos < size) {
+        const void* hit = memchr(data + pos, 0xAA, size - pos);
+        size_t start = hit ? static_cast<size_t>(static_cast<const uint8_t*>(hit) - data) : size;
+        if (start > pos) {
+            discard(start - pos);
+            pos = start;
+        }
+        if (pos == size) {
+            break;
+        }
+
+        size_t total = 0;
+        Candidate state = examine(data + pos, size - pos, total);
+        if (state == Candidate::FRAME && accept(data + pos, total, frames)) {
+            pos += total;
+        } else if (state == Candidate::NEED_MORE) {
+            pending_.assign(data + pos, data + size);
+            pos = size;
+        } else {
+            discard(1);
+            pos++;
+        }
+    }
+
+    return frames.size() - before;
+}
+
+void Aa55Framer::reset() {
+    pending_.clear();
+    spent_count_ = 0;
+    stats_ = FramerStats();
+    in_sync_ = true;
+}
+
+// Private helper methods
+
+Aa55Framer::Candidate Aa55Framer::examine(const uint8_t* data, size_t available,
+                                          size_t& total) const {
+    // data[0] is 0xAA
+    if (available < 2) {
+        return Candidate::NEED_MORE;
+    }
+    if (read16(data) != Aa55Codec::kMarker) {
+        return Candidate::FALSE_MARKER;
+    }
+    if (available < Aa55Codec::kHeaderSize) {
+        return Candidate::NEED_MORE;
+    }
+
+    uint16_t length = read16(data + 5);
+    if (length > config_.max_payload) {
+        return Candidate::FALSE_MARKER;
+    }
+    total = Aa55Codec::kHeaderSize + length + (config_.checksum ? Aa55Codec::kChecksumSize : 0);
+    return available >= total ? Candidate::FRAME : Candidate::NEED_MORE;
+}
+
+bool Aa55Framer::accept(const uint8_t* frame, size_t total, std::vector<Aa55View>& frames) {
+    Aa55View view;
+    view.frame = frame;
+    view.size = total;
+    view.command = frame[2];
+    view.sequence = read16(frame + 3);
+    view.length = read16(frame + 5);
+    view.payload = frame + Aa55Codec::kHeaderSize;
+    view.payload_size = view.length;
+
+    if (config_.checksum) {
+        size_t body = Aa55Codec::kHeaderSize + view.length;
+        view.has_checksum = true;
+        view.checksum = read16(frame + body);
+        view.calculated_checksum = inet_checksum(frame, body);
+        view.checksum_valid = view.checksum == view.calculated_checksum;
+        if (!view.checksum_valid) {
+            stats_.checksum_failures++;
+            if (!config_.deliver_bad_checksum) {
+                return false;
+            }
+        }
+    }
+
+    frames.push_back(view);
+    stats_.frames++;
+    in_sync_ = true;
+    return true;
+}
+
+void Aa55Framer::discard(size_t count) {
+    stats_.garbage_bytes += count;
+    if (in_sync_) {
+        stats_.resyncs++;
+        in_sync_ = false;
+    }
+}
+
+} // namespace embedded_test
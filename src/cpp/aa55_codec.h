@@ -0,0 +1,240 @@
+/**================================================================================
+* FILE: aa55_codec.h
+
+* Purpose:
+* 1. Build and parse the AA55 DUT framing protocol in C++
+* 2. Zero-copy header views, batch build/parse over contiguous buffers
+* 3. Incremental framer for byte streams (TCP) with marker resync
+
+* Frame layout (all fields big-endian):
+* [0xAA55][CMD][SEQ][LEN][PAYLOAD][CHECKSUM]
+*  2 bytes 1     2     2   LEN      2 bytes, simple checksum of everything before it
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef AA55_CODEC_H
+#define AA55_CODEC_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "packet_pool.h"
+
+namespace embedded_test {
+
+//One parsed frame, pointing into the caller's bytes (nothing is copied)
+//Mirrors PacketBuilder.parse_packet in dut_connection.py: the payload may
+//be shorter than length when the data is cut short, and the checksum is
+//only checked when all of it is present
+
+struct Aa55View {
+    const uint8_t* frame;           // marker byte
+    size_t size;                    // bytes available from frame
+    uint8_t command;
+    uint16_t sequence;
+    uint16_t length;                // declared payload length
+    const uint8_t* payload;
+    size_t payload_size;            // payload bytes present, at most length
+    bool has_checksum;              // data reaches past the checksum
+    bool checksum_valid;            // only meaningful when has_checksum
+    uint16_t checksum;              // as received
+    uint16_t calculated_checksum;
+
+    Aa55View() : frame(nullptr), size(0), command(0), sequence(0), length(0),
+                 payload(nullptr), payload_size(0), has_checksum(false),
+                 checksum_valid(false), checksum(0), calculated_checksum(0) {}
+};
+
+//Fixed-size parse result for batch parsing (32 bytes, no padding)
+//Offsets refer to the buffer passed to parse_batch, so payloads can be
+//sliced out of it without copying
+
+struct Aa55Record {
+    uint64_t offset;                // frame start
+    uint64_t payload_offset;        // payload start
+    uint32_t payload_size;          // payload bytes present
+    uint16_t sequence;
+    uint16_t length;                // declared payload length
+    uint16_t checksum;              // as received (0 without checksum)
+    uint16_t calculated_checksum;
+    uint8_t command;
+    bool valid;                     // false where parse_packet returns None
+    bool has_checksum;
+    bool checksum_valid;
+};
+
+//Frames built back to back into one buffer
+//Frame i is buffer[offsets[i], offsets[i] + lengths[i]); reuse the same
+//object across calls so the storage is allocated only once
+
+struct Aa55FrameBatch {
+    std::vector<uint8_t> buffer;
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> lengths;
+
+    size_t count() const { return offsets.size(); }
+    ByteSpan frame(size_t index) const {
+        return ByteSpan(buffer.data() + offsets[index], lengths[index]);
+    }
+};
+
+//Result of Aa55Codec::parse_batch
+
+struct Aa55ParseResult {
+    std::vector<Aa55Record> records;
+    size_t valid;                   // records with valid set
+    size_t checksum_failures;       // records with a checksum that does not match
+
+    Aa55ParseResult() : valid(0), checksum_failures(0) {}
+};
+
+//AA55 codec
+//Byte-for-byte compatible with PacketBuilder.build_packet/parse_packet
+
+class Aa55Codec {
+public:
+    static const uint16_t kMarker = 0xAA55;
+    static const size_t kHeaderSize = 7;
+    static const size_t kChecksumSize = 2;
+    static const size_t kMinimumSize = 9;
+    static const size_t kMaxPayload = 0xFFFF;
+
+    //Bytes needed for one frame
+    //param payload_size Payload length
+    //param include_checksum Whether the checksum is appended
+
+    static size_t frame_size(size_t payload_size, bool include_checksum) {
+        return kHeaderSize + payload_size + (include_checksum ? kChecksumSize : 0);
+    }
+
+    //Write one frame into caller storage
+    //param out At least frame_size(payload.size(), include_checksum) bytes
+    //param command Command byte
+    //param sequence Sequence number
+    //param payload Payload (at most kMaxPayload bytes)
+    //param include_checksum Append the checksum
+    //return Bytes written
+
+    static size_t build_into(uint8_t* out, uint8_t command, uint16_t sequence,
+                             ByteSpan payload, bool include_checksum);
+
+    //Build one frame
+    //param command Command byte
+    //param payload Payload (at most kMaxPayload bytes)
+    //param sequence Sequence number
+    //param include_checksum Append the checksum
+    //return Frame bytes
+
+    static std::vector<uint8_t> build(uint8_t command, ByteSpan payload, uint16_t sequence = 0,
+                                      bool include_checksum = true);
+
+    //Parse one frame without copying
+    //param data Received bytes, frame at the start
+    //param view Filled in on success
+    //return false if shorter than kMinimumSize or the marker is wrong
+
+    static bool parse(ByteSpan data, Aa55View& view);
+
+    //Build many frames back to back
+    //param commands Command per frame
+    //param sequences Sequence number per frame
+    //param payloads Payload per frame (at most kMaxPayload bytes each)
+    //param include_checksum Append checksums
+    //param batch Replaced with the frames
+
+    static void build_batch(const uint8_t* commands, const uint16_t* sequences,
+                            const std::vector<ByteSpan>& payloads, bool include_checksum,
+                            Aa55FrameBatch& batch);
+
+    //Parse many frames in one call
+    //Frames that run past the buffer are not valid
+    //param buffer Contiguous storage holding every frame
+    //param offsets Start of each frame in buffer
+    //param lengths Bytes of each frame
+    //param count Number of frames
+    //param result Replaced with one record per frame
+
+    static void parse_batch(ByteSpan buffer, const uint64_t* offsets, const uint32_t* lengths,
+                            size_t count, Aa55ParseResult& result);
+
+    //Parse every frame of a built batch
+    //param batch Frames from build_batch
+    //param result Replaced with one record per frame
+
+    static void parse_batch(const Aa55FrameBatch& batch, Aa55ParseResult& result);
+};
+
+//Settings for Aa55Framer
+
+struct FramerConfig {
+    bool checksum;                  // frames end in the 2-byte checksum
+    bool deliver_bad_checksum;      // yield frames whose checksum fails instead of resyncing
+    uint16_t max_payload;           // a larger LEN is taken as a false marker
+
+    FramerConfig() : checksum(true), deliver_bad_checksum(false), max_payload(0xFFFF) {}
+};
+
+//Aa55Framer counters
+
+struct FramerStats {
+    uint64_t frames;                // frames yielded
+    uint64_t bytes_in;              // bytes pushed
+    uint64_t garbage_bytes;         // bytes discarded while looking for a marker
+    uint64_t resyncs;               // times sync was lost (each run of garbage)
+    uint64_t checksum_failures;     // candidate frames whose checksum did not match
+
+    FramerStats() : frames(0), bytes_in(0), garbage_bytes(0), resyncs(0), checksum_failures(0) {}
+};
+
+//Incremental AA55 framer for stream transports
+//Push chunks exactly as recv() returns them; complete frames come back
+//however the stream was split or coalesced. A frame wholly inside the
+//chunk is returned as a view into it; only a frame that straddles chunks
+//is assembled in the framer's own buffer. A marker followed by an
+//oversized LEN or a bad checksum is treated as noise and the scan resumes
+//one byte later, so a corrupted stream resynchronizes on the next frame
+
+class Aa55Framer {
+public:
+    explicit Aa55Framer(const FramerConfig& config = FramerConfig());
+
+    //Feed the next chunk of the stream
+    //Views stay valid until the next push()/reset() and, for frames inside
+    //chunk, only while the caller keeps chunk alive
+    //param chunk Bytes as received
+    //param frames Complete frames are appended here
+    //return Number of frames appended
+
+    size_t push(ByteSpan chunk, std::vector<Aa55View>& frames);
+
+    //Drop any partial frame and clear the counters (e.g. after reconnecting)
+
+    void reset();
+
+    //Bytes held for a frame that is not complete yet
+    size_t buffered() const { return pending_.size(); }
+
+    const FramerStats& get_statistics() const { return stats_; }
+
+private:
+    enum class Candidate { NEED_MORE, FALSE_MARKER, FRAME };
+
+    FramerConfig config_;
+    FramerStats stats_;
+    std::vector<uint8_t> pending_;  // partial frame carried to the next chunk
+    std::vector<std::vector<uint8_t>> spent_;  // completed straddling frames the last views point into
+    size_t spent_count_;            // entries of spent_ in use; the rest keep their capacity
+    bool in_sync_;
+
+    // Helper methods
+    Candidate examine(const uint8_t* data, size_t available, size_t& total) const;
+    bool accept(const uint8_t* frame, size_t total, std::vector<Aa55View>& frames);
+    void discard(size_t count);
+};
+
+} // namespace embedded_test
+
+#endif // AA55_CODEC_H
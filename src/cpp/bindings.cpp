@@ -14,13 +14,197 @@
 #include <pybind11/stl.h>
 #include <pybind11/chrono.h>
 #include "fast_comms.h"
+#include "comms_reactor.h"
+#include "fanout_group.h"
+#include "traffic_generator.h"
+#include "pcap_replay.h"
+#include "crc32.h"
+#include "aa55_codec.h"
+#include <unordered_map>
 
 namespace py = pybind11;
 using namespace embedded_test;
 
+//Borrowed view of a contiguous Python buffer (bytes, bytearray, memoryview,
+//numpy array); holds the buffer export so the memory stays valid while
+//C++ reads it, without copying
+
+class BufferArg {
+public:
+    explicit BufferArg(py::handle obj) {
+        if (PyObject_GetBuffer(obj.ptr(), &view_, PyBUF_SIMPLE) != 0) {
+            throw py::error_already_set();
+        }
+    }
+    
+    BufferArg(BufferArg&& other) noexcept : view_(other.view_) {
+        other.view_.obj = nullptr;
+    }
+    
+    ~BufferArg() {
+        if (view_.obj != nullptr) {
+            PyBuffer_Release(&view_);
+        }
+    }
+    
+    BufferArg(const BufferArg&) = delete;
+    BufferArg& operator=(const BufferArg&) = delete;
+    
+    ByteSpan span() const {
+        return ByteSpan(static_cast<const uint8_t*>(view_.buf), static_cast<size_t>(view_.len));
+    }
+    
+private:
+    Py_buffer view_;
+};
+
+//Borrow every buffer in a sequence; holders keeps the exports alive
+
+static std::vector<ByteSpan> borrow_all(const py::sequence& items, std::vector<BufferArg>& holders) {
+    std::vector<ByteSpan> spans;
+    holders.reserve(items.size());
+    spans.reserve(items.size());
+    
+    for (py::handle item : items) {
+        holders.emplace_back(item);
+        spans.push_back(holders.back().span());
+    }
+    
+    return spans;
+}
+
+//Copy a 1-D integer array (numpy, array.array, memoryview) or any
+//sequence of ints into a std::vector; buffers are converted without
+//touching Python objects per element
+
+template <typename T>
+static std::vector<T> index_array(py::handle obj) {
+    if (PyObject_CheckBuffer(obj.ptr())) {
+        py::buffer_info info = py::reinterpret_borrow<py::buffer>(obj).request();
+        char code = info.format.empty() ? 0 : info.format.back();
+        bool is_signed = code == 'b' || code == 'h' || code == 'i' || code == 'l' || code == 'q';
+        bool is_unsigned = code == 'B' || code == 'H' || code == 'I' || code == 'L' || code == 'Q';
+        if (info.ndim == 1 && (is_signed || is_unsigned)) {
+            std::vector<T> values(static_cast<size_t>(info.shape[0]));
+            const uint8_t* base = static_cast<const uint8_t*>(info.ptr);
+            for (size_t i = 0; i < values.size(); i++) {
+                const uint8_t* item = base + static_cast<ssize_t>(i) * info.strides[0];
+                int64_t value = 0;
+                switch (info.itemsize) {
+                case 1: value = is_signed ? *reinterpret_cast<const int8_t*>(item) : *item; break;
+                case 2: value = is_signed ? *reinterpret_cast<const int16_t*>(item)
+                                          : *reinterpret_cast<const uint16_t*>(item); break;
+                case 4: value = is_signed ? *reinterpret_cast<const int32_t*>(item)
+                                          : *reinterpret_cast<const uint32_t*>(item); break;
+                default: value = *reinterpret_cast<const int64_t*>(item); break;
+                }
+                values[i] = static_cast<T>(value);
+            }
+            return values;
+        }
+    }
+    return obj.cast<std::vector<T>>();
+}
+
+static py::bytes to_bytes(const uint8_t* data, size_t length) {
+    return py::bytes(reinterpret_cast<const char*>(data), length);
+}
+
+//Live buffer exports per batch. A memoryview or numpy array of a batch
+//points straight at its storage, so a refill that resizes or swaps that
+//storage must wait until every export is released. Only touched with
+//the GIL held
+
+static std::unordered_map<const void*, size_t> g_batch_exports;
+static getbufferproc g_base_getbuffer = nullptr;
+static releasebufferproc g_base_releasebuffer = nullptr;
+
+template <typename Batch>
+static int counted_getbuffer(PyObject* obj, Py_buffer* view, int flags) {
+    int result = g_base_getbuffer(obj, view, flags);
+    if (result == 0) {
+        g_batch_exports[py::handle(obj).cast<Batch*>()]++;
+    }
+    return result;
+}
+
+template <typename Batch>
+static void counted_releasebuffer(PyObject* obj, Py_buffer* view) {
+    auto it = g_batch_exports.find(py::handle(obj).cast<Batch*>());
+    if (it != g_batch_exports.end() && --it->second == 0) {
+        g_batch_exports.erase(it);
+    }
+    g_base_releasebuffer(obj, view);
+}
+
+//Wrap the buffer slots pybind11 installed for a batch class with counting ones
+
+template <typename Batch>
+static void count_exports(py::handle cls) {
+    PyBufferProcs* procs = reinterpret_cast<PyTypeObject*>(cls.ptr())->tp_as_buffer;
+    g_base_getbuffer = procs->bf_getbuffer;
+    g_base_releasebuffer = procs->bf_releasebuffer;
+    procs->bf_getbuffer = counted_getbuffer<Batch>;
+    procs->bf_releasebuffer = counted_releasebuffer<Batch>;
+}
+
+//Refuse to refill a batch that is still exported
+
+static void check_not_exported(const void* batch) {
+    if (g_batch_exports.count(batch) != 0) {
+        throw py::buffer_error("Batch is still exported as a memoryview or array; "
+                               "release it before refilling");
+    }
+}
+
 PYBIND11_MODULE(fast_comms_cpp, m) {
     m.doc() = "High-performance C++ communication module for embedded device testing";
     
+    // HistogramConfig structure
+    py::class_<HistogramConfig>(m, "HistogramConfig")
+        .def(py::init<>())
+        .def_readwrite("lowest_ns", &HistogramConfig::lowest_ns)
+        .def_readwrite("highest_ns", &HistogramConfig::highest_ns)
+        .def_readwrite("significant_digits", &HistogramConfig::significant_digits);
+    
+    // LatencyHistogram class
+    py::class_<LatencyHistogram>(m, "LatencyHistogram")
+        .def(py::init<>())
+        .def(py::init<const HistogramConfig&>(), py::arg("config"))
+        .def("record", &LatencyHistogram::record, py::arg("value_ns"))
+        .def("add", &LatencyHistogram::add, py::arg("other"),
+             "Merge another histogram's counts")
+        .def("reset", &LatencyHistogram::reset)
+        .def_property_readonly("count", &LatencyHistogram::count)
+        .def_property_readonly("min", &LatencyHistogram::min)
+        .def_property_readonly("max", &LatencyHistogram::max)
+        .def_property_readonly("mean", &LatencyHistogram::mean)
+        .def_property_readonly("stddev", &LatencyHistogram::stddev)
+        .def_property_readonly("config", &LatencyHistogram::config)
+        .def("percentile", &LatencyHistogram::percentile,
+             py::arg("percent"),
+             "Value (ns) at or below which percent of the samples fall\n\n"
+             "Args:\n"
+             "    percent: 0..100, e.g. 99.9")
+        .def("percentiles",
+             [](const LatencyHistogram& histogram, const std::vector<double>& percents) {
+                 py::dict values;
+                 for (double percent : percents) {
+                     values[py::float_(percent)] = histogram.percentile(percent);
+                 }
+                 return values;
+             },
+             py::arg("percents") = std::vector<double>{50.0, 99.0, 99.9, 99.99},
+             "Several percentiles at once\n\n"
+             "Returns:\n"
+             "    dict: percent -> value in nanoseconds")
+        .def("__repr__", [](const LatencyHistogram& histogram) {
+            return "<LatencyHistogram count=" + std::to_string(histogram.count()) +
+                   " p50=" + std::to_string(histogram.percentile(50.0)) +
+                   "ns p99=" + std::to_string(histogram.percentile(99.0)) +
+                   "ns max=" + std::to_string(histogram.max()) + "ns>";
+        });
+    
     // PacketStats structure
     py::class_<PacketStats>(m, "PacketStats")
         .def(py::init<>())
@@ -29,25 +213,263 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
         .def_readwrite("bytes_sent", &PacketStats::bytes_sent)
         .def_readwrite("bytes_received", &PacketStats::bytes_received)
         .def_readwrite("errors", &PacketStats::errors)
+        .def_readwrite("kernel_drops", &PacketStats::kernel_drops)
         .def_readwrite("avg_latency_us", &PacketStats::avg_latency_us)
+        .def_readonly("latency", &PacketStats::latency)
         .def("__repr__", [](const PacketStats& stats) {
             return "<PacketStats sent=" + std::to_string(stats.packets_sent) +
                    " received=" + std::to_string(stats.packets_received) +
-                   " errors=" + std::to_string(stats.errors) + ">";
+                   " errors=" + std::to_string(stats.errors) +
+                   " kernel_drops=" + std::to_string(stats.kernel_drops) + ">";
         });
     
     // CommResult structure
     py::class_<CommResult>(m, "CommResult")
         .def(py::init<>())
         .def_readwrite("success", &CommResult::success)
-        .def_readwrite("data", &CommResult::data)
+        .def_property("data",
+            [](const CommResult& result) {
+                return to_bytes(result.data.data(), result.data.size());
+            },
+            [](CommResult& result, py::buffer data) {
+                BufferArg arg(data);
+                result.data.assign(arg.span().begin(), arg.span().end());
+            })
         .def_readwrite("latency_us", &CommResult::latency_us)
+        .def_readwrite("latency_ns", &CommResult::latency_ns)
+        .def_readwrite("tx_timestamp_ns", &CommResult::tx_timestamp_ns)
+        .def_readwrite("rx_timestamp_ns", &CommResult::rx_timestamp_ns)
         .def_readwrite("error_message", &CommResult::error_message)
         .def("__repr__", [](const CommResult& result) {
             return "<CommResult success=" + std::string(result.success ? "True" : "False") +
                    " latency=" + std::to_string(result.latency_us) + "us>";
         });
     
+    // CaptureConfig structure
+    py::class_<CaptureConfig>(m, "CaptureConfig")
+        .def(py::init<>())
+        .def_readwrite("path", &CaptureConfig::path)
+        .def_readwrite("transmit", &CaptureConfig::transmit)
+        .def_readwrite("snap_length", &CaptureConfig::snap_length)
+        .def_readwrite("max_file_bytes", &CaptureConfig::max_file_bytes)
+        .def_readwrite("max_files", &CaptureConfig::max_files)
+        .def_readwrite("buffer_bytes", &CaptureConfig::buffer_bytes)
+        .def_readwrite("flush_interval_ms", &CaptureConfig::flush_interval_ms);
+    
+    // CaptureStats structure
+    py::class_<CaptureStats>(m, "CaptureStats")
+        .def(py::init<>())
+        .def_readonly("frames_captured", &CaptureStats::frames_captured)
+        .def_readonly("frames_dropped", &CaptureStats::frames_dropped)
+        .def_readonly("frames_written", &CaptureStats::frames_written)
+        .def_readonly("bytes_written", &CaptureStats::bytes_written)
+        .def_readonly("files", &CaptureStats::files)
+        .def_readonly("write_errors", &CaptureStats::write_errors)
+        .def("__repr__", [](const CaptureStats& stats) {
+            return "<CaptureStats written=" + std::to_string(stats.frames_written) +
+                   " dropped=" + std::to_string(stats.frames_dropped) +
+                   " files=" + std::to_string(stats.files) + ">";
+        });
+    
+    // StressConfig structure
+    py::class_<StressConfig>(m, "StressConfig")
+        .def(py::init<>())
+        .def_readwrite("threads", &StressConfig::threads)
+        .def_readwrite("cpus", &StressConfig::cpus)
+        .def_readwrite("packet_size", &StressConfig::packet_size)
+        .def_property("frame",
+            [](const StressConfig& config) {
+                return to_bytes(config.frame.data(), config.frame.size());
+            },
+            [](StressConfig& config, py::buffer data) {
+                BufferArg arg(data);
+                config.frame.assign(arg.span().begin(), arg.span().end());
+            })
+        .def_readwrite("qdisc_bypass", &StressConfig::qdisc_bypass);
+    
+    // StressResult structure
+    py::class_<StressResult>(m, "StressResult")
+        .def(py::init<>())
+        .def_readonly("total", &StressResult::total)
+        .def_readonly("per_thread", &StressResult::per_thread)
+        .def_readonly("elapsed_s", &StressResult::elapsed_s)
+        .def_readonly("pps", &StressResult::pps)
+        .def_readonly("mbps", &StressResult::mbps)
+        .def("__repr__", [](const StressResult& result) {
+            return "<StressResult threads=" + std::to_string(result.per_thread.size()) +
+                   " sent=" + std::to_string(result.total.packets_sent) +
+                   " pps=" + std::to_string(static_cast<uint64_t>(result.pps)) + ">";
+        });
+    
+    // ReceiveBatch structure
+    py::class_<ReceiveBatch>(m, "ReceiveBatch", py::buffer_protocol())
+        .def(py::init<>())
+        .def_buffer([](ReceiveBatch& batch) {
+            // One row per frame slot; lengths says how much of each row is valid
+            return py::buffer_info(batch.buffer.data(), 1,
+                                   py::format_descriptor<uint8_t>::format(), 2,
+                                   {batch.count(), batch.slot_size},
+                                   {batch.slot_size, static_cast<size_t>(1)},
+                                   true);
+        })
+        .def_readonly("lengths", &ReceiveBatch::lengths)
+        .def_readonly("timestamps_ns", &ReceiveBatch::timestamps_ns)
+        .def("__len__", &ReceiveBatch::count)
+        .def("__getitem__", [](const ReceiveBatch& batch, size_t index) {
+            if (index >= batch.count()) {
+                throw py::index_error();
+            }
+            return to_bytes(batch.frame(index), batch.lengths[index]);
+        })
+        .def("frames", [](const ReceiveBatch& batch) {
+            py::list frames;
+            for (size_t i = 0; i < batch.count(); i++) {
+                frames.append(to_bytes(batch.frame(i), batch.lengths[i]));
+            }
+            return frames;
+        }, "Get all frames as a list of bytes")
+        .def("__repr__", [](const ReceiveBatch& batch) {
+            return "<ReceiveBatch frames=" + std::to_string(batch.count()) + ">";
+        });
+    count_exports<ReceiveBatch>(m.attr("ReceiveBatch"));
+    
+    // PoolStats structure
+    py::class_<PoolStats>(m, "PoolStats")
+        .def(py::init<>())
+        .def_readonly("slabs", &PoolStats::slabs)
+        .def_readonly("capacity", &PoolStats::capacity)
+        .def_readonly("in_use", &PoolStats::in_use)
+        .def_readonly("acquires", &PoolStats::acquires)
+        .def_readonly("exhausted", &PoolStats::exhausted)
+        .def("__repr__", [](const PoolStats& stats) {
+            return "<PoolStats capacity=" + std::to_string(stats.capacity) +
+                   " in_use=" + std::to_string(stats.in_use) +
+                   " exhausted=" + std::to_string(stats.exhausted) + ">";
+        });
+    
+    // PacketBuffer handle
+    py::class_<PacketBuffer>(m, "PacketBuffer", py::buffer_protocol())
+        .def_buffer([](PacketBuffer& buffer) {
+            if (!buffer.valid()) {
+                throw py::value_error("PacketBuffer is empty");
+            }
+            return py::buffer_info(buffer.data(), 1,
+                                   py::format_descriptor<uint8_t>::format(), 1,
+                                   {buffer.size()},
+                                   {static_cast<size_t>(1)});
+        })
+        .def("__len__", &PacketBuffer::size)
+        .def("__bool__", &PacketBuffer::valid)
+        .def_property_readonly("capacity", &PacketBuffer::capacity)
+        .def_property_readonly("timestamp_ns", &PacketBuffer::timestamp_ns)
+        .def_property_readonly("use_count", &PacketBuffer::use_count)
+        .def("set_size", &PacketBuffer::set_size,
+             py::arg("length"),
+             "Set the valid length (clamped to capacity)")
+        .def("tobytes", [](const PacketBuffer& buffer) {
+            return to_bytes(buffer.valid() ? buffer.data() : nullptr, buffer.size());
+        }, "Copy the valid bytes into a bytes object")
+        .def("release", &PacketBuffer::reset,
+             "Return the buffer to its pool now")
+        .def("__repr__", [](const PacketBuffer& buffer) {
+            return "<PacketBuffer size=" + std::to_string(buffer.size()) +
+                   " capacity=" + std::to_string(buffer.capacity()) + ">";
+        });
+    
+    // PacketPool class
+    py::class_<PacketPool>(m, "PacketPool")
+        .def(py::init<size_t, size_t, size_t>(),
+             py::arg("buffer_size") = 2048,
+             py::arg("buffers_per_slab") = 1024,
+             py::arg("max_slabs") = 64,
+             "Create a pool of fixed-size packet buffers\n\n"
+             "Args:\n"
+             "    buffer_size: Usable bytes per buffer\n"
+             "    buffers_per_slab: Buffers added each time the pool grows\n"
+             "    max_slabs: Growth limit")
+        .def("acquire", &PacketPool::acquire,
+             py::keep_alive<0, 1>(),
+             "Take a free buffer (empty PacketBuffer if the pool is exhausted)")
+        .def("reserve", &PacketPool::reserve,
+             py::arg("buffers"),
+             "Grow the pool ahead of time\n\n"
+             "Returns:\n"
+             "    bool: True if the capacity was reached")
+        .def("available", &PacketPool::available,
+             "Buffers ready to be acquired without growing")
+        .def_property_readonly("buffer_size", &PacketPool::buffer_size)
+        .def("get_statistics", &PacketPool::get_statistics,
+             "Get pool counters\n\n"
+             "Returns:\n"
+             "    PoolStats: Slabs, capacity, buffers in use, acquires, exhaustion");
+    
+    // TxMode enum
+    py::enum_<TxMode>(m, "TxMode")
+        .value("SOCKET", TxMode::SOCKET)
+        .value("MMAP_RING", TxMode::MMAP_RING)
+        .value("SENDMMSG", TxMode::SENDMMSG)
+        .value("XDP", TxMode::XDP)
+        .value("IO_URING", TxMode::IO_URING);
+    
+    // RxMode enum
+    py::enum_<RxMode>(m, "RxMode")
+        .value("SOCKET", RxMode::SOCKET)
+        .value("MMAP_RING", RxMode::MMAP_RING)
+        .value("XDP", RxMode::XDP);
+    
+    // XdpConfig structure
+    py::class_<XdpConfig>(m, "XdpConfig")
+        .def(py::init<>())
+        .def_readwrite("queue_id", &XdpConfig::queue_id)
+        .def_readwrite("frame_size", &XdpConfig::frame_size)
+        .def_readwrite("frame_count", &XdpConfig::frame_count)
+        .def_readwrite("ring_size", &XdpConfig::ring_size)
+        .def_readwrite("zero_copy", &XdpConfig::zero_copy)
+        .def_readwrite("generic_only", &XdpConfig::generic_only);
+    
+    py::class_<PacketFilter>(m, "PacketFilter")
+        .def(py::init<>())
+        .def("compile", &PacketFilter::compile, py::arg("expression"),
+             "Compile a match expression; False on error (see error)")
+        .def_property_readonly("expression", &PacketFilter::expression)
+        .def_property_readonly("error", &PacketFilter::error)
+        .def("instructions",
+            [](const PacketFilter& filter) {
+                py::list out;
+                for (const struct sock_filter& insn : filter.program()) {
+                    out.append(py::make_tuple(insn.code, insn.jt, insn.jf, insn.k));
+                }
+                return out;
+            },
+            "Compiled program as (code, jt, jf, k) tuples");
+    
+    py::class_<PipelineConfig>(m, "PipelineConfig")
+        .def(py::init<>())
+        .def_readwrite("window", &PipelineConfig::window)
+        .def_readwrite("timeout_ms", &PipelineConfig::timeout_ms)
+        .def_readwrite("header_offset", &PipelineConfig::header_offset)
+        .def_property("matcher",
+            [](const PipelineConfig& config) { return static_cast<bool>(config.matcher); },
+            [](PipelineConfig& config, py::object matcher) {
+                if (matcher.is_none()) {
+                    config.matcher = ResponseMatcher();
+                    return;
+                }
+                // Called from the worker with the GIL released; return an
+                // int key, or None for frames without one
+                py::function function = matcher.cast<py::function>();
+                config.matcher = [function](ByteSpan frame, uint32_t& key) {
+                    py::gil_scoped_acquire acquire;
+                    py::object result = function(to_bytes(frame.data(), frame.size()));
+                    if (result.is_none()) {
+                        return false;
+                    }
+                    key = result.cast<uint32_t>();
+                    return true;
+                };
+            },
+            "Callable(frame: bytes) -> int | None; replaces the AA55 SEQ matcher");
+    
     // FastComms class
     py::class_<FastComms>(m, "FastComms")
         .def(py::init<const std::string&, uint32_t>(),
@@ -59,39 +481,137 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
              "    timeout_ms: Timeout in milliseconds (default: 1000)")
         
         .def("initialize", &FastComms::initialize,
+             py::arg("tx_mode") = TxMode::SOCKET,
+             py::arg("rx_mode") = RxMode::SOCKET,
+             py::call_guard<py::gil_scoped_release>(),
              "Initialize the communication channel\n\n"
+             "Args:\n"
+             "    tx_mode: TxMode.SOCKET, MMAP_RING, SENDMMSG, XDP or IO_URING (default: SOCKET)\n"
+             "    rx_mode: RxMode.SOCKET, MMAP_RING or XDP (default: SOCKET)\n\n"
              "Returns:\n"
              "    bool: True if successful")
         
         .def("close", &FastComms::close,
+             py::call_guard<py::gil_scoped_release>(),
              "Close the communication channel")
         
-        .def("send_packet", &FastComms::send_packet,
+        .def("send_packet",
+             [](FastComms& self, py::buffer data) {
+                 BufferArg arg(data);
+                 py::gil_scoped_release release;
+                 return self.send_packet(arg.span());
+             },
              py::arg("data"),
              "Send raw packet\n\n"
              "Args:\n"
-             "    data: Packet data as bytes\n\n"
+             "    data: Packet data (bytes, bytearray, memoryview or numpy array)\n\n"
              "Returns:\n"
              "    bool: True if sent successfully")
         
         .def("receive_packet", 
              [](FastComms& self, size_t max_size) {
                  std::vector<uint8_t> buffer;
-                 int result = self.receive_packet(buffer, max_size);
-                 return py::make_tuple(result, buffer);
+                 int result;
+                 {
+                     py::gil_scoped_release release;
+                     result = self.receive_packet(buffer, max_size);
+                 }
+                 return py::make_tuple(result, to_bytes(buffer.data(), buffer.size()));
              },
              py::arg("max_size") = 4096,
              "Receive raw packet with timeout\n\n"
              "Args:\n"
              "    max_size: Maximum size to receive\n\n"
              "Returns:\n"
-             "    tuple: (bytes_received, data)")
+             "    tuple: (bytes_received, data as bytes)")
+        
+        .def("receive_into_buffer",
+             static_cast<int (FastComms::*)(PacketBuffer&)>(&FastComms::receive_packet),
+             py::arg("buffer"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Receive raw packet into a pooled buffer (no allocation)\n\n"
+             "Args:\n"
+             "    buffer: PacketBuffer from PacketPool.acquire()\n\n"
+             "Returns:\n"
+             "    int: Bytes received, 0 on timeout, -1 on error")
+        
+        .def("receive_view",
+             [](FastComms& self) -> py::object {
+                 PacketView view;
+                 int received;
+                 {
+                     py::gil_scoped_release release;
+                     received = self.receive_view(view);
+                 }
+                 if (received <= 0) {
+                     return py::none();
+                 }
+                 return py::memoryview::from_memory(static_cast<const void*>(view.data), view.length);
+             },
+             "Receive a frame without copying (RxMode.MMAP_RING and XDP only)\n\n"
+             "The memoryview points into the RX ring or UMEM and is only valid\n"
+             "until the next receive call; copy it with bytes() to keep it.\n"
+             "The calling thread becomes the channel's only receiver; receive\n"
+             "calls from other threads fail until close()\n\n"
+             "Returns:\n"
+             "    memoryview: Frame data, or None on timeout or error")
+        
+        .def("receive_batch",
+             [](FastComms& self, size_t max_frames, uint32_t timeout_ms, size_t max_frame_size) {
+                 ReceiveBatch batch;
+                 {
+                     py::gil_scoped_release release;
+                     self.receive_batch(batch, max_frames, timeout_ms, max_frame_size);
+                 }
+                 return batch;
+             },
+             py::arg("max_frames"),
+             py::arg("timeout_ms"),
+             py::arg("max_frame_size") = 2048,
+             "Receive many frames with one syscall\n\n"
+             "Args:\n"
+             "    max_frames: Maximum number of frames to return\n"
+             "    timeout_ms: Time to wait for the first frame\n"
+             "    max_frame_size: Per-frame capture size (default: 2048)\n\n"
+             "Returns:\n"
+             "    ReceiveBatch: Frames with per-frame lengths and timestamps")
+        
+        .def("receive_into",
+             [](FastComms& self, ReceiveBatch& batch, size_t max_frames, uint32_t timeout_ms,
+                size_t max_frame_size) {
+                 check_not_exported(&batch);
+                 py::gil_scoped_release release;
+                 return self.receive_batch(batch, max_frames, timeout_ms, max_frame_size);
+             },
+             py::arg("batch"),
+             py::arg("max_frames"),
+             py::arg("timeout_ms"),
+             py::arg("max_frame_size") = 2048,
+             "Receive many frames into an existing ReceiveBatch (reuses its storage)\n\n"
+             "Args:\n"
+             "    batch: ReceiveBatch to fill\n"
+             "    max_frames: Maximum number of frames to return\n"
+             "    timeout_ms: Time to wait for the first frame\n"
+             "    max_frame_size: Per-frame capture size (default: 2048)\n\n"
+             "Returns:\n"
+             "    int: Frames received, 0 on timeout, -1 on error\n\n"
+             "Raises:\n"
+             "    BufferError: A memoryview or array of batch is still alive")
+        
+        .def("set_receive_buffer_size", &FastComms::set_receive_buffer_size,
+             py::arg("bytes"),
+             "Set the kernel socket receive buffer size\n\n"
+             "Args:\n"
+             "    bytes: Buffer size in bytes\n\n"
+             "Returns:\n"
+             "    bool: True if successful")
         
         .def("send_and_receive",
-             [](FastComms& self, const std::vector<uint8_t>& request) {
+             [](FastComms& self, py::buffer request) {
+                 BufferArg arg(request);
                  std::vector<uint8_t> response;
-                 CommResult result = self.send_and_receive(request, response);
-                 return result;
+                 py::gil_scoped_release release;
+                 return self.send_and_receive(arg.span(), response);
              },
              py::arg("request"),
              "Send packet and wait for response\n\n"
@@ -100,7 +620,52 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
              "Returns:\n"
              "    CommResult: Result with response data and latency")
         
-        .def("burst_send", &FastComms::burst_send,
+        .def("send_and_receive_batch",
+             [](FastComms& self, py::sequence requests) {
+                 std::vector<BufferArg> holders;
+                 std::vector<ByteSpan> spans = borrow_all(requests, holders);
+                 std::vector<CommResult> results;
+                 {
+                     py::gil_scoped_release release;
+                     self.send_and_receive_batch(spans, results);
+                 }
+                 return results;
+             },
+             py::arg("requests"),
+             "Send many requests with their receives kept in flight together\n"
+             "(io_uring in TxMode.IO_URING, sequential otherwise)\n\n"
+             "Args:\n"
+             "    requests: List of request data\n\n"
+             "Returns:\n"
+             "    list: CommResult per request, in request order")
+        
+        .def("send_and_receive_pipelined",
+             [](FastComms& self, py::sequence requests, const PipelineConfig& config) {
+                 std::vector<BufferArg> holders;
+                 std::vector<ByteSpan> spans = borrow_all(requests, holders);
+                 std::vector<CommResult> results;
+                 {
+                     py::gil_scoped_release release;
+                     self.send_and_receive_pipelined(spans, results, config);
+                 }
+                 return results;
+             },
+             py::arg("requests"), py::arg("config") = PipelineConfig(),
+             "Keep a window of requests in flight, pairing responses by key\n"
+             "(AA55 SEQ by default); each request times out on its own\n\n"
+             "Args:\n"
+             "    requests: List of request frames\n"
+             "    config: PipelineConfig (window, timeout_ms, header_offset, matcher)\n\n"
+             "Returns:\n"
+             "    list: CommResult per request, in request order")
+        
+        .def("burst_send",
+             [](FastComms& self, py::sequence packets) {
+                 std::vector<BufferArg> holders;
+                 std::vector<ByteSpan> spans = borrow_all(packets, holders);
+                 py::gil_scoped_release release;
+                 return self.burst_send(spans);
+             },
              py::arg("packets"),
              "Burst send multiple packets\n\n"
              "Args:\n"
@@ -108,7 +673,32 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
              "Returns:\n"
              "    int: Number of packets successfully sent")
         
-        .def("measure_latency", &FastComms::measure_latency,
+        .def("burst_send_with_status",
+             [](FastComms& self, py::sequence packets) {
+                 std::vector<BufferArg> holders;
+                 std::vector<ByteSpan> spans = borrow_all(packets, holders);
+                 std::vector<uint8_t> accepted;
+                 int sent;
+                 {
+                     py::gil_scoped_release release;
+                     sent = self.burst_send(spans, accepted);
+                 }
+                 std::vector<bool> status(accepted.begin(), accepted.end());
+                 return py::make_tuple(sent, status);
+             },
+             py::arg("packets"),
+             "Burst send multiple packets and report which were accepted\n\n"
+             "Args:\n"
+             "    packets: List of packet data\n\n"
+             "Returns:\n"
+             "    tuple: (packets_sent, list of bool per packet)")
+        
+        .def("measure_latency",
+             [](FastComms& self, py::buffer payload) {
+                 BufferArg arg(payload);
+                 py::gil_scoped_release release;
+                 return self.measure_latency(arg.span());
+             },
              py::arg("payload"),
              "Measure round-trip latency\n\n"
              "Args:\n"
@@ -116,9 +706,56 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
              "Returns:\n"
              "    int: Latency in microseconds, -1 on error")
         
+        .def("measure_latency_ns",
+             [](FastComms& self, py::buffer payload) {
+                 BufferArg arg(payload);
+                 py::gil_scoped_release release;
+                 return self.measure_latency_ns(arg.span());
+             },
+             py::arg("payload"),
+             "Measure round-trip latency (kernel timestamps when enabled)\n\n"
+             "Args:\n"
+             "    payload: Ping payload\n\n"
+             "Returns:\n"
+             "    int: Latency in nanoseconds, -1 on error")
+        
+        .def("enable_timestamping", &FastComms::enable_timestamping,
+             py::arg("hardware") = false,
+             "Use SO_TIMESTAMPING kernel timestamps for send_and_receive latency\n\n"
+             "Args:\n"
+             "    hardware: Also try NIC timestamps (falls back to software)\n\n"
+             "Returns:\n"
+             "    bool: True if timestamping is active")
+        
+        .def("has_hardware_timestamps", &FastComms::has_hardware_timestamps,
+             "Check whether NIC timestamps are in use")
+        
+        .def("start_capture", &FastComms::start_capture,
+             py::arg("config"),
+             "Record received (and optionally sent) frames to a pcapng file\n\n"
+             "A background thread writes the file; frames it cannot keep up\n"
+             "with are counted as dropped\n\n"
+             "Args:\n"
+             "    config: CaptureConfig (path, transmit, rotation)\n\n"
+             "Returns:\n"
+             "    bool: True if the capture file was created")
+        
+        .def("stop_capture", &FastComms::stop_capture,
+             py::call_guard<py::gil_scoped_release>(),
+             "Flush and close the capture file")
+        
+        .def("is_capturing", &FastComms::is_capturing,
+             "Check whether a capture is running")
+        
+        .def("get_capture_statistics", &FastComms::get_capture_statistics,
+             "Get capture counters\n\n"
+             "Returns:\n"
+             "    CaptureStats: Frames written and dropped, files opened")
+        
         .def("stress_test", &FastComms::stress_test,
              py::arg("duration_ms"),
              py::arg("packet_size") = 64,
+             py::call_guard<py::gil_scoped_release>(),
              "Stress test - send packets at maximum rate\n\n"
              "Args:\n"
              "    duration_ms: Duration in milliseconds\n"
@@ -126,6 +763,21 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
              "Returns:\n"
              "    PacketStats: Statistics about the stress test")
         
+        .def("stress_test_parallel", &FastComms::stress_test_parallel,
+             py::arg("duration_ms"),
+             py::arg("config") = StressConfig(),
+             py::call_guard<py::gil_scoped_release>(),
+             "Stress test with several pinned transmit threads\n\n"
+             "Each worker sends on its own transmit-only socket in this channel's TX mode\n\n"
+             "Args:\n"
+             "    duration_ms: Duration in milliseconds\n"
+             "    config: StressConfig (threads, cpus, frame, qdisc_bypass)\n\n"
+             "Returns:\n"
+             "    StressResult: Aggregate and per-thread statistics")
+        
+        .def("stop_stress_test", &FastComms::stop_stress_test,
+             "Make a running stress test return early")
+        
         .def("get_statistics", &FastComms::get_statistics,
              "Get communication statistics\n\n"
              "Returns:\n"
@@ -145,18 +797,134 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
              "Returns:\n"
              "    bool: True if ready for communication")
         
+        .def("get_tx_mode", &FastComms::get_tx_mode,
+             "Get the active transmit path\n\n"
+             "Returns:\n"
+             "    TxMode: Mode in use (SOCKET if the ring could not be set up)")
+        
+        .def("get_rx_mode", &FastComms::get_rx_mode,
+             "Get the active receive path\n\n"
+             "Returns:\n"
+             "    RxMode: Mode in use (SOCKET if the ring could not be set up)")
+        
+        .def("set_tx_batch_size", &FastComms::set_tx_batch_size,
+             py::arg("batch_size"),
+             "Set frames per sendmmsg() call in TxMode.SENDMMSG\n\n"
+             "Args:\n"
+             "    batch_size: Frames per syscall")
+        
+        .def("set_xdp_config", &FastComms::set_xdp_config,
+             py::arg("config"),
+             "Set AF_XDP options (applies at next initialize)\n\n"
+             "Args:\n"
+             "    config: XdpConfig")
+        
+        .def("is_xdp_zero_copy", &FastComms::is_xdp_zero_copy,
+             "Check whether the AF_XDP socket runs in zero-copy mode\n\n"
+             "Returns:\n"
+             "    bool: True if zero-copy")
+        
+        .def("get_fd", &FastComms::get_fd,
+             "Get the descriptor that becomes readable when frames arrive\n\n"
+             "Returns:\n"
+             "    int: File descriptor, -1 if closed")
+        
+        .def("set_latency_histogram", &FastComms::set_latency_histogram,
+             py::arg("config"),
+             "Set range and precision of the round-trip histogram (clears it)\n\n"
+             "Args:\n"
+             "    config: HistogramConfig")
+        
+        .def("set_qdisc_bypass", &FastComms::set_qdisc_bypass,
+             py::arg("enable"),
+             "Send straight to the driver, skipping the qdisc (applies at next initialize)\n\n"
+             "Args:\n"
+             "    enable: True to bypass the qdisc")
+        
+        .def("set_transmit_only", &FastComms::set_transmit_only,
+             py::arg("enable"),
+             "Open a send-only socket that receives nothing (applies at next initialize)\n\n"
+             "Args:\n"
+             "    enable: True for a transmit-only socket")
+        
+        .def("set_rx_block_timeout", &FastComms::set_rx_block_timeout,
+             py::arg("timeout_ms"),
+             "Set RX ring block retire timeout (applies at next initialize)\n\n"
+             "Args:\n"
+             "    timeout_ms: Timeout in milliseconds")
+        
+        .def("set_filter", &FastComms::set_filter,
+             py::arg("expression"),
+             "Drop non-matching frames in the kernel (classic BPF)\n\n"
+             "Example: 'ether type 0x88b5 or udp port 5000'\n\n"
+             "Args:\n"
+             "    expression: Match expression, '' to accept all\n\n"
+             "Returns:\n"
+             "    bool: False if the expression is invalid")
+        
+        .def("clear_filter", &FastComms::clear_filter,
+             "Remove the receive filter")
+        
+        .def("get_filter", &FastComms::get_filter,
+             "Get the active filter expression")
+        
         .def("__enter__", [](FastComms& self) -> FastComms& {
+            py::gil_scoped_release release;
             self.initialize();
             return self;
         })
         
         .def("__exit__", [](FastComms& self, py::object, py::object, py::object) {
+            py::gil_scoped_release release;
             self.close();
         });
     
+    // IntegrityCheck enum
+    py::enum_<IntegrityCheck>(m, "IntegrityCheck")
+        .value("CRC32", IntegrityCheck::CRC32)
+        .value("CRC32_BE", IntegrityCheck::CRC32_BE)
+        .value("CHECKSUM16", IntegrityCheck::CHECKSUM16);
+    
+    // BatchValidation structure
+    py::class_<BatchValidation>(m, "BatchValidation")
+        .def_readonly("frames", &BatchValidation::frames)
+        .def_readonly("failures", &BatchValidation::failures)
+        .def_property_readonly("bitmap", [](const BatchValidation& result) {
+            // Byte i bit j is frame 8*i + j (the words are stored little-endian)
+            std::string bitmap((result.frames + 7) / 8, '\0');
+            for (size_t i = 0; i < bitmap.size(); i++) {
+                bitmap[i] = static_cast<char>(result.failure_bitmap[i / 8] >> (8 * (i % 8)));
+            }
+            return py::bytes(bitmap);
+        }, "Failure bitmap, bit (i % 8) of byte i // 8 set when frame i failed")
+        .def("failed", [](const BatchValidation& result, size_t index) {
+            if (index >= result.frames) {
+                throw py::index_error();
+            }
+            return result.failed(index);
+        }, py::arg("index"))
+        .def("failed_indices", [](const BatchValidation& result) {
+            py::list indices;
+            for (size_t w = 0; w < result.failure_bitmap.size(); w++) {
+                for (uint64_t bits = result.failure_bitmap[w]; bits != 0; bits &= bits - 1) {
+                    indices.append(w * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+                }
+            }
+            return indices;
+        }, "Indices of the frames that failed")
+        .def("__repr__", [](const BatchValidation& result) {
+            return "<BatchValidation frames=" + std::to_string(result.frames) +
+                   " failures=" + std::to_string(result.failures) + ">";
+        });
+    
     // PacketValidator class
     py::class_<PacketValidator>(m, "PacketValidator")
-        .def_static("calculate_crc32", &PacketValidator::calculate_crc32,
+        .def_static("calculate_crc32",
+                   [](py::buffer data) {
+                       BufferArg arg(data);
+                       py::gil_scoped_release release;
+                       return PacketValidator::calculate_crc32(arg.span());
+                   },
                    py::arg("data"),
                    "Calculate CRC32 checksum\n\n"
                    "Args:\n"
@@ -164,7 +932,12 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
                    "Returns:\n"
                    "    int: CRC32 value")
         
-        .def_static("verify_packet", &PacketValidator::verify_packet,
+        .def_static("verify_packet",
+                   [](py::buffer packet, uint32_t expected_crc) {
+                       BufferArg arg(packet);
+                       py::gil_scoped_release release;
+                       return PacketValidator::verify_packet(arg.span(), expected_crc);
+                   },
                    py::arg("packet"),
                    py::arg("expected_crc"),
                    "Verify packet integrity\n\n"
@@ -174,13 +947,409 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
                    "Returns:\n"
                    "    bool: True if valid")
         
-        .def_static("calculate_simple_checksum", &PacketValidator::calculate_simple_checksum,
+        .def_static("calculate_simple_checksum",
+                   [](py::buffer data) {
+                       BufferArg arg(data);
+                       py::gil_scoped_release release;
+                       return PacketValidator::calculate_simple_checksum(arg.span());
+                   },
                    py::arg("data"),
                    "Calculate simple checksum\n\n"
                    "Args:\n"
                    "    data: Data to checksum\n\n"
                    "Returns:\n"
-                   "    int: Checksum value");
+                   "    int: Checksum value")
+        
+        .def_static("update_checksum",
+                   [](uint16_t checksum, py::buffer old_field, py::buffer new_field) {
+                       BufferArg old_arg(old_field);
+                       BufferArg new_arg(new_field);
+                       py::gil_scoped_release release;
+                       return PacketValidator::update_checksum(checksum, old_arg.span(), new_arg.span());
+                   },
+                   py::arg("checksum"),
+                   py::arg("old_field"),
+                   py::arg("new_field"),
+                   "Update a simple checksum after a field changed (RFC 1624)\n\n"
+                   "Args:\n"
+                   "    checksum: Checksum before the change\n"
+                   "    old_field: Field bytes before the change (even offset)\n"
+                   "    new_field: Field bytes after the change, same length\n\n"
+                   "Returns:\n"
+                   "    int: Checksum after the change")
+        
+        .def_static("validate_batch",
+                   [](const ReceiveBatch& batch, IntegrityCheck check, unsigned threads) {
+                       py::gil_scoped_release release;
+                       return PacketValidator::validate_batch(batch, check, threads);
+                   },
+                   py::arg("batch"),
+                   py::arg("check") = IntegrityCheck::CRC32,
+                   py::arg("threads") = 1,
+                   "Check the integrity trailer of every frame in a ReceiveBatch\n\n"
+                   "Args:\n"
+                   "    batch: Frames from FastComms.receive_batch\n"
+                   "    check: IntegrityCheck trailer format\n"
+                   "    threads: Workers, 0 = one per CPU\n\n"
+                   "Returns:\n"
+                   "    BatchValidation: Failure count and bitmap")
+        
+        .def_static("validate_batch",
+                   [](py::buffer buffer, py::object offsets, py::object lengths,
+                      IntegrityCheck check, unsigned threads) {
+                       BufferArg arg(buffer);
+                       std::vector<uint64_t> starts = index_array<uint64_t>(offsets);
+                       std::vector<uint32_t> sizes = index_array<uint32_t>(lengths);
+                       if (starts.size() != sizes.size()) {
+                           throw py::value_error("offsets and lengths must have the same length");
+                       }
+                       py::gil_scoped_release release;
+                       return PacketValidator::validate_batch(arg.span(), starts.data(), sizes.data(),
+                                                              starts.size(), check, threads);
+                   },
+                   py::arg("buffer"),
+                   py::arg("offsets"),
+                   py::arg("lengths"),
+                   py::arg("check") = IntegrityCheck::CRC32,
+                   py::arg("threads") = 1,
+                   "Check the integrity trailer of many frames in one call\n\n"
+                   "Args:\n"
+                   "    buffer: Contiguous bytes holding every frame\n"
+                   "    offsets: Start of each frame (numpy/array of ints or a list)\n"
+                   "    lengths: Length of each frame, trailer included\n"
+                   "    check: IntegrityCheck trailer format\n"
+                   "    threads: Workers, 0 = one per CPU\n\n"
+                   "Returns:\n"
+                   "    BatchValidation: Failure count and bitmap; frames that run\n"
+                   "    past the buffer or are shorter than the trailer fail");
+    
+    // Crc32Stream class
+    py::class_<Crc32Stream>(m, "Crc32Stream")
+        .def(py::init<>())
+        
+        .def("update",
+             [](Crc32Stream& self, py::buffer data, unsigned threads) {
+                 BufferArg arg(data);
+                 py::gil_scoped_release release;
+                 self.update(arg.span().data(), arg.span().size(), threads);
+             },
+             py::arg("data"),
+             py::arg("threads") = 1,
+             "Add the next chunk\n\n"
+             "Args:\n"
+             "    data: Bytes-like chunk, any size\n"
+             "    threads: Workers for large chunks, 0 = one per CPU")
+        
+        .def("update_file", &Crc32Stream::update_file,
+             py::arg("path"),
+             py::arg("threads") = 0,
+             py::call_guard<py::gil_scoped_release>(),
+             "Add a file's contents without loading it into Python\n\n"
+             "Args:\n"
+             "    path: File to checksum (memory-mapped)\n"
+             "    threads: Workers, 0 = one per CPU\n\n"
+             "Returns:\n"
+             "    bool: False if the file cannot be read")
+        
+        .def("append", &Crc32Stream::append,
+             py::arg("next"),
+             "Add everything another stream has seen, as if its data followed")
+        
+        .def("finalize", &Crc32Stream::finalize,
+             "CRC-32 of everything added so far (same value as calculate_crc32)")
+        
+        .def("reset", &Crc32Stream::reset,
+             "Start over")
+        
+        .def_property_readonly("length", &Crc32Stream::length)
+        .def("__repr__", [](const Crc32Stream& self) {
+            return "<Crc32Stream crc=" + std::to_string(self.finalize()) +
+                   " length=" + std::to_string(self.length()) + ">";
+        });
+    
+    m.def("crc32_combine", &crc32_combine,
+          py::arg("crc1"),
+          py::arg("crc2"),
+          py::arg("length2"),
+          "CRC-32 of two pieces joined together, from the CRC of each\n\n"
+          "Args:\n"
+          "    crc1: CRC-32 of the first piece\n"
+          "    crc2: CRC-32 of the second piece\n"
+          "    length2: Length of the second piece in bytes\n\n"
+          "Returns:\n"
+          "    int: CRC-32 of the first piece followed by the second");
+    
+    // Aa55Record structure
+    py::class_<Aa55Record>(m, "Aa55Record")
+        .def_readonly("offset", &Aa55Record::offset)
+        .def_readonly("payload_offset", &Aa55Record::payload_offset)
+        .def_readonly("payload_size", &Aa55Record::payload_size)
+        .def_readonly("sequence", &Aa55Record::sequence)
+        .def_readonly("length", &Aa55Record::length)
+        .def_readonly("checksum", &Aa55Record::checksum)
+        .def_readonly("calculated_checksum", &Aa55Record::calculated_checksum)
+        .def_readonly("command", &Aa55Record::command)
+        .def_readonly("valid", &Aa55Record::valid)
+        .def_readonly("has_checksum", &Aa55Record::has_checksum)
+        .def_readonly("checksum_valid", &Aa55Record::checksum_valid)
+        .def("__repr__", [](const Aa55Record& record) {
+            return "<Aa55Record valid=" + std::string(record.valid ? "True" : "False") +
+                   " command=" + std::to_string(record.command) +
+                   " sequence=" + std::to_string(record.sequence) +
+                   " length=" + std::to_string(record.length) + ">";
+        });
+    
+    // Aa55FrameBatch structure
+    py::class_<Aa55FrameBatch>(m, "Aa55FrameBatch", py::buffer_protocol())
+        .def(py::init<>())
+        .def_buffer([](Aa55FrameBatch& batch) {
+            // All frames back to back; offsets/lengths locate each one
+            return py::buffer_info(batch.buffer.data(), 1,
+                                   py::format_descriptor<uint8_t>::format(), 1,
+                                   {batch.buffer.size()}, {static_cast<size_t>(1)}, true);
+        })
+        .def_readonly("offsets", &Aa55FrameBatch::offsets)
+        .def_readonly("lengths", &Aa55FrameBatch::lengths)
+        .def("__len__", &Aa55FrameBatch::count)
+        .def("__getitem__", [](const Aa55FrameBatch& batch, size_t index) {
+            if (index >= batch.count()) {
+                throw py::index_error();
+            }
+            ByteSpan frame = batch.frame(index);
+            return to_bytes(frame.data(), frame.size());
+        })
+        .def("frames", [](const Aa55FrameBatch& batch) {
+            py::list frames;
+            for (size_t i = 0; i < batch.count(); i++) {
+                ByteSpan frame = batch.frame(i);
+                frames.append(to_bytes(frame.data(), frame.size()));
+            }
+            return frames;
+        }, "Get all frames as a list of bytes")
+        .def("__repr__", [](const Aa55FrameBatch& batch) {
+            return "<Aa55FrameBatch frames=" + std::to_string(batch.count()) +
+                   " bytes=" + std::to_string(batch.buffer.size()) + ">";
+        });
+    count_exports<Aa55FrameBatch>(m.attr("Aa55FrameBatch"));
+    
+    // Aa55ParseResult structure
+    py::class_<Aa55ParseResult>(m, "Aa55ParseResult", py::buffer_protocol())
+        .def_buffer([](Aa55ParseResult& result) {
+            // One Aa55Record per frame, e.g. numpy.asarray(result)["sequence"]
+            return py::buffer_info(result.records.data(), sizeof(Aa55Record),
+                                   "T{=Q:offset:=Q:payload_offset:=I:payload_size:"
+                                   "=H:sequence:=H:length:=H:checksum:=H:calculated_checksum:"
+                                   "=B:command:=?:valid:=?:has_checksum:=?:checksum_valid:}",
+                                   1, {result.records.size()}, {sizeof(Aa55Record)}, true);
+        })
+        .def_readonly("valid", &Aa55ParseResult::valid)
+        .def_readonly("checksum_failures", &Aa55ParseResult::checksum_failures)
+        .def("__len__", [](const Aa55ParseResult& result) { return result.records.size(); })
+        .def("__getitem__", [](const Aa55ParseResult& result, size_t index) {
+            if (index >= result.records.size()) {
+                throw py::index_error();
+            }
+            return result.records[index];
+        })
+        .def("__repr__", [](const Aa55ParseResult& result) {
+            return "<Aa55ParseResult frames=" + std::to_string(result.records.size()) +
+                   " valid=" + std::to_string(result.valid) +
+                   " checksum_failures=" + std::to_string(result.checksum_failures) + ">";
+        });
+    
+    // Aa55Codec class
+    py::class_<Aa55Codec>(m, "Aa55Codec")
+        .def_static("build",
+                   [](uint8_t command, py::buffer payload, uint16_t sequence, bool include_checksum) {
+                       BufferArg arg(payload);
+                       if (arg.span().size() > Aa55Codec::kMaxPayload) {
+                           throw py::value_error("AA55 payload is limited to 65535 bytes");
+                       }
+                       std::string frame(Aa55Codec::frame_size(arg.span().size(), include_checksum), '\0');
+                       Aa55Codec::build_into(reinterpret_cast<uint8_t*>(&frame[0]), command, sequence,
+                                             arg.span(), include_checksum);
+                       return py::bytes(frame);
+                   },
+                   py::arg("command"),
+                   py::arg("payload") = py::bytes(),
+                   py::arg("sequence") = 0,
+                   py::arg("include_checksum") = true,
+                   "Build one frame (same bytes as PacketBuilder.build_packet)\n\n"
+                   "Args:\n"
+                   "    command: Command byte\n"
+                   "    payload: Payload, at most 65535 bytes\n"
+                   "    sequence: Sequence number\n"
+                   "    include_checksum: Append the checksum\n\n"
+                   "Returns:\n"
+                   "    bytes: Frame")
+        
+        .def_static("parse",
+                   [](py::buffer data) -> py::object {
+                       BufferArg arg(data);
+                       Aa55View view;
+                       if (!Aa55Codec::parse(arg.span(), view)) {
+                           return py::none();
+                       }
+                       py::dict result;
+                       result["command"] = view.command;
+                       result["sequence"] = view.sequence;
+                       result["length"] = view.length;
+                       result["payload"] = to_bytes(view.payload, view.payload_size);
+                       if (view.has_checksum) {
+                           result["checksum_valid"] = view.checksum_valid;
+                       }
+                       return result;
+                   },
+                   py::arg("data"),
+                   "Parse one frame (same result as PacketBuilder.parse_packet)\n\n"
+                   "Args:\n"
+                   "    data: Received bytes, frame at the start\n\n"
+                   "Returns:\n"
+                   "    dict: command, sequence, length, payload and, when the\n"
+                   "    checksum is present, checksum_valid; None if not a frame")
+        
+        .def_static("build_batch",
+                   [](py::object commands, py::object sequences, py::sequence payloads,
+                      bool include_checksum) {
+                       std::vector<uint64_t> command_values = index_array<uint64_t>(commands);
+                       std::vector<uint64_t> sequence_values = index_array<uint64_t>(sequences);
+                       if (command_values.size() != payloads.size() ||
+                           sequence_values.size() != payloads.size()) {
+                           throw py::value_error("commands, sequences and payloads must have the same length");
+                       }
+                       
+                       std::vector<uint8_t> command_bytes(command_values.size());
+                       std::vector<uint16_t> sequence_words(sequence_values.size());
+                       for (size_t i = 0; i < command_values.size(); i++) {
+                           if (command_values[i] > 0xFF || sequence_values[i] > 0xFFFF) {
+                               throw py::value_error("command must fit in 8 bits and sequence in 16 bits");
+                           }
+                           command_bytes[i] = static_cast<uint8_t>(command_values[i]);
+                           sequence_words[i] = static_cast<uint16_t>(sequence_values[i]);
+                       }
+                       
+                       std::vector<BufferArg> holders;
+                       std::vector<ByteSpan> spans = borrow_all(payloads, holders);
+                       for (const ByteSpan& span : spans) {
+                           if (span.size() > Aa55Codec::kMaxPayload) {
+                               throw py::value_error("AA55 payload is limited to 65535 bytes");
+                           }
+                       }
+                       
+                       Aa55FrameBatch batch;
+                       {
+                           py::gil_scoped_release release;
+                           Aa55Codec::build_batch(command_bytes.data(), sequence_words.data(), spans,
+                                                  include_checksum, batch);
+                       }
+                       return batch;
+                   },
+                   py::arg("commands"),
+                   py::arg("sequences"),
+                   py::arg("payloads"),
+                   py::arg("include_checksum") = true,
+                   "Build many frames into one contiguous buffer\n\n"
+                   "Args:\n"
+                   "    commands: Command byte per frame (array of ints or a list)\n"
+                   "    sequences: Sequence number per frame\n"
+                   "    payloads: Sequence of bytes-like payloads\n"
+                   "    include_checksum: Append checksums\n\n"
+                   "Returns:\n"
+                   "    Aa55FrameBatch: Frames back to back with offsets and lengths")
+        
+        .def_static("parse_batch",
+                   [](const Aa55FrameBatch& batch) {
+                       Aa55ParseResult result;
+                       py::gil_scoped_release release;
+                       Aa55Codec::parse_batch(batch, result);
+                       return result;
+                   },
+                   py::arg("batch"),
+                   "Parse every frame of an Aa55FrameBatch\n\n"
+                   "Returns:\n"
+                   "    Aa55ParseResult: One record per frame, usable as a numpy structured array")
+        
+        .def_static("parse_batch",
+                   [](py::buffer buffer, py::object offsets, py::object lengths) {
+                       BufferArg arg(buffer);
+                       std::vector<uint64_t> starts = index_array<uint64_t>(offsets);
+                       std::vector<uint32_t> sizes = index_array<uint32_t>(lengths);
+                       if (starts.size() != sizes.size()) {
+                           throw py::value_error("offsets and lengths must have the same length");
+                       }
+                       Aa55ParseResult result;
+                       py::gil_scoped_release release;
+                       Aa55Codec::parse_batch(arg.span(), starts.data(), sizes.data(), starts.size(), result);
+                       return result;
+                   },
+                   py::arg("buffer"),
+                   py::arg("offsets"),
+                   py::arg("lengths"),
+                   "Parse many frames in one call\n\n"
+                   "Args:\n"
+                   "    buffer: Contiguous bytes holding every frame\n"
+                   "    offsets: Start of each frame (numpy/array of ints or a list)\n"
+                   "    lengths: Bytes of each frame\n\n"
+                   "Returns:\n"
+                   "    Aa55ParseResult: One record per frame; payload i is\n"
+                   "    buffer[payload_offset:payload_offset + payload_size]");
+    
+    // FramerConfig structure
+    py::class_<FramerConfig>(m, "FramerConfig")
+        .def(py::init<>())
+        .def_readwrite("checksum", &FramerConfig::checksum)
+        .def_readwrite("deliver_bad_checksum", &FramerConfig::deliver_bad_checksum)
+        .def_readwrite("max_payload", &FramerConfig::max_payload);
+    
+    // FramerStats structure
+    py::class_<FramerStats>(m, "FramerStats")
+        .def(py::init<>())
+        .def_readonly("frames", &FramerStats::frames)
+        .def_readonly("bytes_in", &FramerStats::bytes_in)
+        .def_readonly("garbage_bytes", &FramerStats::garbage_bytes)
+        .def_readonly("resyncs", &FramerStats::resyncs)
+        .def_readonly("checksum_failures", &FramerStats::checksum_failures)
+        .def("__repr__", [](const FramerStats& stats) {
+            return "<FramerStats frames=" + std::to_string(stats.frames) +
+                   " garbage_bytes=" + std::to_string(stats.garbage_bytes) +
+                   " resyncs=" + std::to_string(stats.resyncs) + ">";
+        });
+    
+    // Aa55Framer class
+    py::class_<Aa55Framer>(m, "Aa55Framer")
+        .def(py::init<const FramerConfig&>(),
+             py::arg("config") = FramerConfig())
+        .def("push",
+             [](Aa55Framer& self, py::buffer chunk) {
+                 BufferArg arg(chunk);
+                 std::vector<Aa55View> frames;
+                 {
+                     py::gil_scoped_release release;
+                     self.push(arg.span(), frames);
+                 }
+                 py::list result;
+                 for (const Aa55View& view : frames) {
+                     result.append(to_bytes(view.frame, view.size));
+                 }
+                 return result;
+             },
+             py::arg("chunk"),
+             "Feed the next chunk of a TCP stream\n\n"
+             "Chunks may split or coalesce frames arbitrarily; noise and\n"
+             "frames with a bad checksum are skipped\n\n"
+             "Args:\n"
+             "    chunk: Bytes as returned by recv()\n\n"
+             "Returns:\n"
+             "    list: Complete frames (bytes), in stream order")
+        .def("reset", &Aa55Framer::reset,
+             "Drop any partial frame and clear the counters")
+        .def_property_readonly("buffered", &Aa55Framer::buffered,
+             "Bytes held for a frame that is not complete yet")
+        .def("get_statistics", &Aa55Framer::get_statistics,
+             py::return_value_policy::copy,
+             "Get framer counters\n\n"
+             "Returns:\n"
+             "    FramerStats: Frames, garbage bytes, resyncs and checksum failures");
     
     // PerformanceMonitor class
     py::class_<PerformanceMonitor>(m, "PerformanceMonitor")
@@ -194,4 +1363,393 @@ PYBIND11_MODULE(fast_comms_cpp, m) {
         .def("get_throughput_mbps", &PerformanceMonitor::get_throughput_mbps,
              py::arg("bytes_transferred"),
              "Calculate throughput in Mbps");
+    
+    // ReactorStats structure
+    py::class_<ReactorStats>(m, "ReactorStats")
+        .def(py::init<>())
+        .def_readonly("wakeups", &ReactorStats::wakeups)
+        .def_readonly("frames", &ReactorStats::frames)
+        .def_readonly("queue_drops", &ReactorStats::queue_drops)
+        .def_readonly("closed", &ReactorStats::closed)
+        .def("__repr__", [](const ReactorStats& stats) {
+            return "<ReactorStats frames=" + std::to_string(stats.frames) +
+                   " wakeups=" + std::to_string(stats.wakeups) +
+                   " queue_drops=" + std::to_string(stats.queue_drops) + ">";
+        });
+    
+    // ReactorBatch structure
+    py::class_<ReactorBatch>(m, "ReactorBatch", py::buffer_protocol())
+        .def(py::init<>())
+        .def_buffer([](ReactorBatch& batch) {
+            // Frames packed back to back; slice with offsets and lengths
+            return py::buffer_info(batch.buffer.data(), 1,
+                                   py::format_descriptor<uint8_t>::format(), 1,
+                                   {batch.buffer.size()},
+                                   {static_cast<size_t>(1)},
+                                   true);
+        })
+        .def_readonly("channels", &ReactorBatch::channels)
+        .def_readonly("offsets", &ReactorBatch::offsets)
+        .def_readonly("lengths", &ReactorBatch::lengths)
+        .def_readonly("timestamps_ns", &ReactorBatch::timestamps_ns)
+        .def("__len__", &ReactorBatch::count)
+        .def("__getitem__", [](const ReactorBatch& batch, size_t index) {
+            if (index >= batch.count()) {
+                throw py::index_error();
+            }
+            return py::make_tuple(batch.channels[index],
+                                  to_bytes(batch.frame(index), batch.lengths[index]));
+        })
+        .def("frames", [](const ReactorBatch& batch) {
+            py::list frames;
+            for (size_t i = 0; i < batch.count(); i++) {
+                frames.append(py::make_tuple(batch.channels[i],
+                                             to_bytes(batch.frame(i), batch.lengths[i])));
+            }
+            return frames;
+        }, "Get all frames as a list of (channel_id, bytes)")
+        .def("__repr__", [](const ReactorBatch& batch) {
+            return "<ReactorBatch frames=" + std::to_string(batch.count()) + ">";
+        });
+    count_exports<ReactorBatch>(m.attr("ReactorBatch"));
+    
+    // CommsReactor class
+    py::class_<CommsReactor>(m, "CommsReactor")
+        .def(py::init<>())
+        .def("add_channel",
+             [](CommsReactor& self, FastComms& comms) {
+                 return self.add_channel(comms);
+             },
+             py::arg("comms"),
+             py::keep_alive<1, 2>(),
+             "Register an initialized FastComms channel; frames are queued for drain()\n\n"
+             "Args:\n"
+             "    comms: FastComms instance\n\n"
+             "Returns:\n"
+             "    int: Channel id, -1 on error")
+        
+        .def("add_socket",
+             [](CommsReactor& self, int fd) {
+                 return self.add_socket(fd);
+             },
+             py::arg("fd"),
+             "Register a TCP/UDP socket (switched to non-blocking); reads are queued\n\n"
+             "Args:\n"
+             "    fd: Socket file descriptor (e.g. sock.fileno())\n\n"
+             "Returns:\n"
+             "    int: Channel id, -1 on error")
+        
+        .def("remove", &CommsReactor::remove,
+             py::arg("channel_id"),
+             "Deregister a channel")
+        
+        .def("is_registered", &CommsReactor::is_registered,
+             py::arg("channel_id"),
+             "Check whether a channel is still registered")
+        
+        .def("channel_count", &CommsReactor::channel_count,
+             "Number of registered channels")
+        
+        .def("run_once", &CommsReactor::run_once,
+             py::arg("timeout_ms"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Wait for readiness once and dispatch ready channels\n\n"
+             "Args:\n"
+             "    timeout_ms: Maximum wait in milliseconds\n\n"
+             "Returns:\n"
+             "    int: Frames dispatched, -1 on error")
+        
+        .def("run_for", &CommsReactor::run_for,
+             py::arg("duration_ms"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Dispatch until duration_ms has elapsed or stop() is called\n\n"
+             "Args:\n"
+             "    duration_ms: Run time in milliseconds\n\n"
+             "Returns:\n"
+             "    int: Frames dispatched, -1 on error")
+        
+        .def("stop", &CommsReactor::stop,
+             "Make run_for() return after the current pass")
+        
+        .def("drain",
+             [](CommsReactor& self) {
+                 ReactorBatch batch;
+                 self.drain(batch);
+                 return batch;
+             },
+             "Take all queued frames\n\n"
+             "Returns:\n"
+             "    ReactorBatch: Frames with channel ids, lengths and timestamps")
+        
+        .def("drain_into",
+             [](CommsReactor& self, ReactorBatch& batch) {
+                 check_not_exported(&batch);
+                 return self.drain(batch);
+             },
+             py::arg("batch"),
+             "Move queued frames into an existing ReactorBatch (reuses its storage)\n\n"
+             "Returns:\n"
+             "    int: Frames moved\n\n"
+             "Raises:\n"
+             "    BufferError: A memoryview or array of batch is still alive")
+        
+        .def("pending", &CommsReactor::pending,
+             "Frames waiting in the queue")
+        
+        .def("set_queue_limit", &CommsReactor::set_queue_limit,
+             py::arg("max_frames"),
+             "Cap the queue; further frames are counted in queue_drops")
+        
+        .def("set_budget", &CommsReactor::set_budget,
+             py::arg("frames"),
+             "Frames read from one channel per pass before moving on")
+        
+        .def("get_statistics", &CommsReactor::get_statistics,
+             "Get reactor counters\n\n"
+             "Returns:\n"
+             "    ReactorStats: Wakeups, frames, queue drops, closed sockets");
+    
+    py::enum_<FanoutMode>(m, "FanoutMode")
+        .value("HASH", FanoutMode::HASH)
+        .value("CPU", FanoutMode::CPU)
+        .value("ROUND_ROBIN", FanoutMode::ROUND_ROBIN);
+    
+    py::class_<FanoutConfig>(m, "FanoutConfig")
+        .def(py::init<>())
+        .def_readwrite("workers", &FanoutConfig::workers)
+        .def_readwrite("mode", &FanoutConfig::mode)
+        .def_readwrite("rx_mode", &FanoutConfig::rx_mode)
+        .def_readwrite("cpus", &FanoutConfig::cpus)
+        .def_readwrite("group_id", &FanoutConfig::group_id)
+        .def_readwrite("timeout_ms", &FanoutConfig::timeout_ms)
+        .def_readwrite("filter", &FanoutConfig::filter);
+    
+    // FanoutGroup class
+    py::class_<FanoutGroup>(m, "FanoutGroup")
+        .def(py::init<const std::string&, const FanoutConfig&>(),
+             py::arg("interface_name"),
+             py::arg("config") = FanoutConfig())
+        
+        .def("start",
+             [](FanoutGroup& self) {
+                 py::gil_scoped_release release;
+                 return self.start();
+             },
+             "Open one socket per worker, join the fanout group and start the\n"
+             "pinned workers; frames are queued for drain()\n\n"
+             "Returns:\n"
+             "    bool: True if every worker started")
+        
+        .def("stop", &FanoutGroup::stop,
+             py::call_guard<py::gil_scoped_release>(),
+             "Stop the workers and close their sockets")
+        
+        .def("is_running", &FanoutGroup::is_running)
+        .def("worker_count", &FanoutGroup::worker_count)
+        
+        .def("drain",
+             [](FanoutGroup& self) {
+                 ReactorBatch batch;
+                 {
+                     py::gil_scoped_release release;
+                     self.drain(batch);
+                 }
+                 return batch;
+             },
+             "Take the frames queued by every worker\n\n"
+             "Returns:\n"
+             "    ReactorBatch: Frames; channels holds the worker index")
+        
+        .def("drain_into",
+             [](FanoutGroup& self, ReactorBatch& batch) {
+                 check_not_exported(&batch);
+                 py::gil_scoped_release release;
+                 return self.drain(batch);
+             },
+             py::arg("batch"),
+             "Move queued frames into an existing ReactorBatch (reuses its storage)\n\n"
+             "Raises:\n"
+             "    BufferError: A memoryview or array of batch is still alive")
+        
+        .def("set_queue_limit", &FanoutGroup::set_queue_limit,
+             py::arg("max_frames"),
+             "Cap each worker queue; further frames count as queue drops")
+        
+        .def("get_statistics", &FanoutGroup::get_statistics,
+             "Get counters summed over all workers")
+        
+        .def("get_worker_statistics", &FanoutGroup::get_worker_statistics,
+             py::arg("worker"),
+             "Get the counters of one worker")
+        
+        .def("get_queue_drops", &FanoutGroup::get_queue_drops,
+             "Frames discarded because a worker queue was full")
+        
+        .def("__enter__", [](FanoutGroup& self) -> FanoutGroup& {
+            py::gil_scoped_release release;
+            self.start();
+            return self;
+        })
+        
+        .def("__exit__", [](FanoutGroup& self, py::object, py::object, py::object) {
+            py::gil_scoped_release release;
+            self.stop();
+        });
+    
+    py::enum_<LoadProfile>(m, "LoadProfile")
+        .value("CONSTANT", LoadProfile::CONSTANT)
+        .value("STEP_RAMP", LoadProfile::STEP_RAMP)
+        .value("SINE", LoadProfile::SINE)
+        .value("POISSON", LoadProfile::POISSON);
+    
+    py::class_<TrafficProfile>(m, "TrafficProfile")
+        .def(py::init<>())
+        .def_readwrite("shape", &TrafficProfile::shape)
+        .def_readwrite("rate", &TrafficProfile::rate)
+        .def_readwrite("rate_in_bps", &TrafficProfile::rate_in_bps)
+        .def_readwrite("start_rate", &TrafficProfile::start_rate)
+        .def_readwrite("steps", &TrafficProfile::steps)
+        .def_readwrite("amplitude", &TrafficProfile::amplitude)
+        .def_readwrite("period_ms", &TrafficProfile::period_ms)
+        .def_readwrite("duration_ms", &TrafficProfile::duration_ms)
+        .def_readwrite("interval_ms", &TrafficProfile::interval_ms)
+        .def_readwrite("seed", &TrafficProfile::seed);
+    
+    py::class_<IntervalReport>(m, "IntervalReport")
+        .def_readonly("start_s", &IntervalReport::start_s)
+        .def_readonly("requested_pps", &IntervalReport::requested_pps)
+        .def_readonly("achieved_pps", &IntervalReport::achieved_pps)
+        .def_readonly("requested_bps", &IntervalReport::requested_bps)
+        .def_readonly("achieved_bps", &IntervalReport::achieved_bps)
+        .def_readonly("packets", &IntervalReport::packets)
+        .def_readonly("errors", &IntervalReport::errors)
+        .def("__repr__", [](const IntervalReport& interval) {
+            return "<IntervalReport t=" + std::to_string(interval.start_s) +
+                   " requested_pps=" + std::to_string(interval.requested_pps) +
+                   " achieved_pps=" + std::to_string(interval.achieved_pps) + ">";
+        });
+    
+    py::class_<TrafficReport>(m, "TrafficReport")
+        .def_readonly("intervals", &TrafficReport::intervals)
+        .def_readonly("totals", &TrafficReport::totals)
+        .def_readonly("scheduled", &TrafficReport::scheduled)
+        .def_readonly("skipped", &TrafficReport::skipped)
+        .def_readonly("elapsed_s", &TrafficReport::elapsed_s);
+    
+    // TrafficGenerator class
+    py::class_<TrafficGenerator>(m, "TrafficGenerator")
+        .def(py::init<FastComms&>(),
+             py::arg("comms"),
+             py::keep_alive<1, 2>())
+        
+        .def("set_frames",
+             [](TrafficGenerator& self, py::sequence frames) {
+                 std::vector<BufferArg> holders;
+                 std::vector<ByteSpan> spans = borrow_all(frames, holders);
+                 std::vector<std::vector<uint8_t>> copies;
+                 copies.reserve(spans.size());
+                 for (const ByteSpan& span : spans) {
+                     copies.emplace_back(span.begin(), span.end());
+                 }
+                 self.set_frames(copies);
+             },
+             py::arg("frames"),
+             "Frames to send, used round-robin (copied once)")
+        
+        .def("set_sequence_offset", &TrafficGenerator::set_sequence_offset,
+             py::arg("offset"),
+             "Write a 32-bit big-endian sequence number at offset (-1 disables)")
+        
+        .def("set_spin_threshold_us", &TrafficGenerator::set_spin_threshold_us,
+             py::arg("microseconds"),
+             "Waits shorter than this are spun instead of slept")
+        
+        .def("set_max_lag_us", &TrafficGenerator::set_max_lag_us,
+             py::arg("microseconds"),
+             "How far the sender may fall behind before packets are skipped")
+        
+        .def("run", &TrafficGenerator::run,
+             py::arg("profile"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Generate paced traffic for the profile's duration\n\n"
+             "Args:\n"
+             "    profile: TrafficProfile\n\n"
+             "Returns:\n"
+             "    TrafficReport: Requested vs achieved rate per interval")
+        
+        .def("stop", &TrafficGenerator::stop,
+             "Make run() return early (call from another thread)");
+    
+    // Capture replay
+    py::enum_<ReplayTiming>(m, "ReplayTiming")
+        .value("ORIGINAL", ReplayTiming::ORIGINAL)
+        .value("FIXED_RATE", ReplayTiming::FIXED_RATE)
+        .value("TOP_SPEED", ReplayTiming::TOP_SPEED);
+    
+    py::class_<ReplayConfig>(m, "ReplayConfig")
+        .def(py::init<>())
+        .def_readwrite("timing", &ReplayConfig::timing)
+        .def_readwrite("speed", &ReplayConfig::speed)
+        .def_readwrite("pps", &ReplayConfig::pps)
+        .def_readwrite("loops", &ReplayConfig::loops)
+        .def_property("dst_mac",
+            [](const ReplayConfig& config) {
+                return to_bytes(config.dst_mac.data(), config.dst_mac.size());
+            },
+            [](ReplayConfig& config, py::buffer data) {
+                BufferArg arg(data);
+                config.dst_mac.assign(arg.span().begin(), arg.span().end());
+            })
+        .def_property("src_mac",
+            [](const ReplayConfig& config) {
+                return to_bytes(config.src_mac.data(), config.src_mac.size());
+            },
+            [](ReplayConfig& config, py::buffer data) {
+                BufferArg arg(data);
+                config.src_mac.assign(arg.span().begin(), arg.span().end());
+            })
+        .def_readwrite("spin_threshold_us", &ReplayConfig::spin_threshold_us);
+    
+    py::class_<ReplayReport>(m, "ReplayReport")
+        .def_readonly("totals", &ReplayReport::totals)
+        .def_readonly("loops", &ReplayReport::loops)
+        .def_readonly("elapsed_s", &ReplayReport::elapsed_s)
+        .def_readonly("scheduled_s", &ReplayReport::scheduled_s)
+        .def_readonly("timing_error", &ReplayReport::timing_error)
+        .def("__repr__", [](const ReplayReport& report) {
+            return "<ReplayReport sent=" + std::to_string(report.totals.packets_sent) +
+                   " loops=" + std::to_string(report.loops) +
+                   " p99_error=" + std::to_string(report.timing_error.percentile(99.0)) + "ns>";
+        });
+    
+    // PcapReplay class
+    py::class_<PcapReplay>(m, "PcapReplay")
+        .def(py::init<FastComms&>(),
+             py::arg("comms"),
+             py::keep_alive<1, 2>())
+        
+        .def("load", &PcapReplay::load,
+             py::arg("path"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Map and index a pcap or pcapng capture (Ethernet only)\n\n"
+             "Args:\n"
+             "    path: Capture file\n\n"
+             "Returns:\n"
+             "    bool: False if unreadable; see error")
+        
+        .def_property_readonly("error", &PcapReplay::error)
+        .def_property_readonly("packet_count", &PcapReplay::packet_count)
+        .def_property_readonly("capture_duration_s", &PcapReplay::capture_duration_s)
+        
+        .def("run", &PcapReplay::run,
+             py::arg("config") = ReplayConfig(),
+             py::call_guard<py::gil_scoped_release>(),
+             "Replay the loaded capture\n\n"
+             "Args:\n"
+             "    config: ReplayConfig (timing, speed/pps, loops, MAC rewrite)\n\n"
+             "Returns:\n"
+             "    ReplayReport: Totals and send-time error against the schedule")
+        
+        .def("stop", &PcapReplay::stop,
+             "Make run() return early (call from another thread)");
 }
@@ -0,0 +1,312 @@
+/**================================================================================
+* FILE: comms_reactor.cpp
+
+* Purpose:
+* 1. Implementation of the epoll reactor
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "comms_reactor.h"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+
+namespace embedded_test {
+
+// Events collected per epoll_wait() call
+static const int kMaxEvents = 256;
+
+// Frames read from one channel per pass unless overridden
+static const uint32_t kDefaultBudget = 64;
+
+// Queued frames kept for drain() unless overridden
+static const size_t kDefaultQueueLimit = 65536;
+
+// Largest single read from a plain socket
+static const size_t kSocketReadSize = 65536;
+
+// Longest single wait inside run_for(), so stop() is noticed promptly
+static const uint32_t kRunSliceMs = 10;
+
+static uint64_t now_ns() {
+    auto now = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+}
+
+CommsReactor::CommsReactor()
+    : epoll_fd_(-1),
+      active_count_(0),
+      queue_limit_(kDefaultQueueLimit),
+      budget_(kDefaultBudget),
+      stop_requested_(false) {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        std::cerr << "Failed to create epoll instance: " << strerror(errno) << std::endl;
+    }
+}
+
+CommsReactor::~CommsReactor() {
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+}
+
+int CommsReactor::add_channel(FastComms& comms, FrameHandler handler) {
+    int fd = comms.get_fd();
+    if (fd < 0) {
+        std::cerr << "Channel must be initialized before registration" << std::endl;
+        return -1;
+    }
+
+    return register_fd(&comms, fd, false, handler);
+}
+
+int CommsReactor::add_socket(int fd, FrameHandler handler) {
+    if (fd < 0) {
+        return -1;
+    }
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        std::cerr << "Failed to make socket non-blocking: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int type = 0;
+    socklen_t len = sizeof(type);
+    bool stream = (getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len) == 0 && type == SOCK_STREAM);
+
+    return register_fd(nullptr, fd, stream, handler);
+}
+
+bool CommsReactor::remove(int channel_id) {
+    if (!is_registered(channel_id)) {
+        return false;
+    }
+
+    Channel& channel = channels_[channel_id];
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, channel.fd, nullptr);
+    channel.active = false;
+    active_count_--;
+
+    return true;
+}
+
+bool CommsReactor::is_registered(int channel_id) const {
+    return channel_id >= 0 &&
+           static_cast<size_t>(channel_id) < channels_.size() &&
+           channels_[channel_id].active;
+}
+
+int CommsReactor::run_once(uint32_t timeout_ms) {
+    if (epoll_fd_ < 0) {
+        return -1;
+    }
+
+    // Channels with leftover data get no new edge, so do not sleep on them
+    int wait_ms = backlog_.empty() ? static_cast<int>(timeout_ms) : 0;
+
+    struct epoll_event events[kMaxEvents];
+    int ready = epoll_wait(epoll_fd_, events, kMaxEvents, wait_ms);
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        return -1;
+    }
+    if (ready > 0) {
+        stats_.wakeups++;
+    }
+
+    int dispatched = 0;
+
+    ready_.clear();
+    ready_.swap(backlog_);
+    for (int channel_id : ready_) {
+        channels_[channel_id].backlog = false;
+        dispatched += service(channel_id);
+    }
+
+    for (int i = 0; i < ready; i++) {
+        int channel_id = static_cast<int>(events[i].data.u32);
+        if (!channels_[channel_id].backlog) {
+            dispatched += service(channel_id);
+        }
+    }
+
+    return dispatched;
+}
+
+int64_t CommsReactor::run_for(uint32_t duration_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+    int64_t total = 0;
+
+    while (!stop_requested_.load(std::memory_order_relaxed)) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+
+        int64_t remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+        uint32_t slice = static_cast<uint32_t>(std::min<int64_t>(remaining_ms + 1, kRunSliceMs));
+
+        int dispatched = run_once(slice);
+        if (dispatched < 0) {
+            stop_requested_.store(false);
+            return -1;
+        }
+        total += dispatched;
+    }
+
+    stop_requested_.store(false);
+    return total;
+}
+
+void CommsReactor::stop() {
+    stop_requested_.store(true);
+}
+
+size_t CommsReactor::drain(ReactorBatch& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    std::swap(out, queue_);
+    return out.count();
+}
+
+size_t CommsReactor::pending() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return queue_.count();
+}
+
+void CommsReactor::set_queue_limit(size_t max_frames) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_limit_ = max_frames;
+}
+
+void CommsReactor::set_budget(uint32_t frames) {
+    budget_ = frames > 0 ? frames : 1;
+}
+
+// Private helper methods
+
+int CommsReactor::register_fd(FastComms* comms, int fd, bool stream, FrameHandler handler) {
+    if (epoll_fd_ < 0) {
+        return -1;
+    }
+
+    int channel_id = static_cast<int>(channels_.size());
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    event.data.u32 = static_cast<uint32_t>(channel_id);
+
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        std::cerr << "Failed to register descriptor: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    channels_.push_back(Channel());
+    Channel& channel = channels_.back();
+    channel.comms = comms;
+    channel.fd = fd;
+    channel.stream = stream;
+    channel.active = true;
+    channel.handler = handler;
+    active_count_++;
+
+    // Frames queued before registration raised no edge; pick them up now
+    channel.backlog = true;
+    backlog_.push_back(channel_id);
+
+    return channel_id;
+}
+
+int CommsReactor::service(int channel_id) {
+    int serviced = 0;
+
+    while (channels_[channel_id].active) {
+        if (static_cast<uint32_t>(serviced) >= budget_) {
+            channels_[channel_id].backlog = true;
+            backlog_.push_back(channel_id);
+            break;
+        }
+
+        Channel& channel = channels_[channel_id];
+        PacketView frame;
+
+        if (channel.comms != nullptr) {
+            if (channel.comms->try_receive(frame) <= 0) {
+                break;
+            }
+        } else {
+            if (scratch_.size() < kSocketReadSize) {
+                scratch_.resize(kSocketReadSize);
+            }
+
+            ssize_t received = recv(channel.fd, scratch_.data(), scratch_.size(), MSG_DONTWAIT);
+            if (received < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    close_channel(channel_id);
+                }
+                break;
+            }
+            if (received == 0 && channel.stream) {
+                close_channel(channel_id);
+                break;
+            }
+
+            frame.data = scratch_.data();
+            frame.length = static_cast<uint32_t>(received);
+            frame.timestamp_ns = now_ns();
+        }
+
+        deliver(channel_id, frame);
+        serviced++;
+    }
+
+    return serviced;
+}
+
+void CommsReactor::deliver(int channel_id, const PacketView& frame) {
+    const Channel& channel = channels_[channel_id];
+
+    if (channel.handler) {
+        stats_.frames++;
+        channel.handler(channel_id, frame);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (queue_.count() >= queue_limit_) {
+        stats_.queue_drops++;
+        return;
+    }
+
+    stats_.frames++;
+    queue_.offsets.push_back(static_cast<uint32_t>(queue_.buffer.size()));
+    queue_.lengths.push_back(frame.length);
+    queue_.channels.push_back(channel_id);
+    queue_.timestamps_ns.push_back(frame.timestamp_ns);
+    queue_.buffer.insert(queue_.buffer.end(), frame.data, frame.data + frame.length);
+}
+
+void CommsReactor::close_channel(int channel_id) {
+    if (remove(channel_id)) {
+        stats_.closed++;
+    }
+}
+
+} // namespace embedded_test
@@ -0,0 +1,184 @@
+/**================================================================================
+* FILE: comms_reactor.h
+
+* Purpose:
+* 1. Edge-triggered epoll loop serving many FastComms channels on one thread
+* 2. Frames go to C++ handlers or a queue that Python drains in bulk
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef COMMS_REACTOR_H
+#define COMMS_REACTOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "fast_comms.h"
+
+namespace embedded_test {
+
+//Called for every frame read from a channel
+//param channel_id Id returned by add_channel()/add_socket()
+//param frame Frame data; only valid during the call
+
+typedef std::function<void(int channel_id, const PacketView& frame)> FrameHandler;
+
+//Frames queued by the reactor, packed back to back in one buffer
+//Swap-drained by CommsReactor::drain(), so the storage is reused
+
+struct ReactorBatch {
+    std::vector<uint8_t> buffer;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> lengths;
+    std::vector<int32_t> channels;
+    std::vector<uint64_t> timestamps_ns;
+
+    size_t count() const { return lengths.size(); }
+    const uint8_t* frame(size_t index) const { return buffer.data() + offsets[index]; }
+
+    void clear() {
+        buffer.clear();
+        offsets.clear();
+        lengths.clear();
+        channels.clear();
+        timestamps_ns.clear();
+    }
+};
+
+//Reactor counters
+
+struct ReactorStats {
+    uint64_t wakeups;       // epoll_wait() calls that returned events
+    uint64_t frames;        // frames handed to handlers or queued
+    uint64_t queue_drops;   // frames discarded because the queue was full
+    uint64_t closed;        // sockets deregistered after EOF or error
+
+    ReactorStats() : wakeups(0), frames(0), queue_drops(0), closed(0) {}
+};
+
+//Single-threaded event loop over many channels
+//Descriptors are registered edge-triggered, so a ready channel is drained
+//until it runs dry. Each channel gets at most budget frames per pass; a
+//channel that still has data is revisited on the next pass without waiting
+//for a new edge, which keeps one busy channel from starving the rest
+
+class CommsReactor {
+public:
+    CommsReactor();
+    ~CommsReactor();
+
+    CommsReactor(const CommsReactor&) = delete;
+    CommsReactor& operator=(const CommsReactor&) = delete;
+
+    //Register an initialized FastComms channel
+    //param comms Channel (must outlive its registration)
+    //param handler Called per frame; frames are queued for drain() if empty
+    //return Channel id, -1 on error
+
+    int add_channel(FastComms& comms, FrameHandler handler = FrameHandler());
+
+    //Register a TCP/UDP socket; it is switched to non-blocking mode
+    //Each read (datagram or stream chunk) is delivered as one frame; the
+    //socket is deregistered on EOF or error but not closed
+    //param fd Socket descriptor (owned by the caller)
+    //param handler Called per read; reads are queued for drain() if empty
+    //return Channel id, -1 on error
+
+    int add_socket(int fd, FrameHandler handler = FrameHandler());
+
+    //Deregister a channel
+    //param channel_id Id returned at registration
+    //return true if the channel was registered
+
+    bool remove(int channel_id);
+
+    //Check whether a channel is still registered
+
+    bool is_registered(int channel_id) const;
+
+    //Number of registered channels
+
+    size_t channel_count() const { return active_count_; }
+
+    //Wait for readiness once and dispatch everything that is ready
+    //param timeout_ms Maximum wait when no channel has pending data
+    //return Number of frames dispatched, -1 on error
+
+    int run_once(uint32_t timeout_ms);
+
+    //Dispatch until duration_ms has elapsed or stop() is called
+    //param duration_ms Run time in milliseconds
+    //return Number of frames dispatched, -1 on error
+
+    int64_t run_for(uint32_t duration_ms);
+
+    //Make run_for() return after the current pass (safe from any thread)
+
+    void stop();
+
+    //Move queued frames into out, replacing its contents
+    //Safe to call from another thread while run_once()/run_for() runs
+    //param out Receives the queued frames (its storage is recycled)
+    //return Number of frames moved
+
+    size_t drain(ReactorBatch& out);
+
+    //Frames waiting in the queue
+
+    size_t pending() const;
+
+    //Cap on queued frames; further frames are counted in queue_drops
+    //param max_frames Maximum queue length
+
+    void set_queue_limit(size_t max_frames);
+
+    //Frames read from one channel before moving on to the next
+    //param frames Per-channel budget per pass (minimum 1)
+
+    void set_budget(uint32_t frames);
+
+    ReactorStats get_statistics() const { return stats_; }
+
+private:
+    struct Channel {
+        FastComms* comms;       // nullptr for plain sockets
+        int fd;
+        bool stream;            // 0-byte read means EOF (TCP) rather than an empty datagram
+        bool active;
+        bool backlog;           // budget ran out with data still queued
+        FrameHandler handler;
+
+        Channel() : comms(nullptr), fd(-1), stream(false),
+                    active(false), backlog(false) {}
+    };
+
+    int epoll_fd_;
+    std::deque<Channel> channels_;  // ids are never reused; deque keeps handlers in place
+    std::vector<int> backlog_;
+    std::vector<int> ready_;
+    size_t active_count_;
+    ReactorBatch queue_;
+    size_t queue_limit_;
+    mutable std::mutex queue_mutex_;    // queue_ and queue_limit_; drain() runs on other threads
+    uint32_t budget_;
+    std::vector<uint8_t> scratch_;
+    std::atomic<bool> stop_requested_;
+    ReactorStats stats_;
+
+    // Helper methods
+    int register_fd(FastComms* comms, int fd, bool stream, FrameHandler handler);
+    int service(int channel_id);
+    void deliver(int channel_id, const PacketView& frame);
+    void close_channel(int channel_id);
+};
+
+} // namespace embedded_test
+
+#endif // COMMS_REACTOR_H
@@ -0,0 +1,440 @@
+/**================================================================================
+* FILE: crc32.cpp
+
+* Purpose:
+* 1. Implementation of the CRC-32 paths and their runtime selection
+* 2. crc32_combine, threaded checksums and the streaming state
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "crc32.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRC32_HAVE_PCLMUL 1
+#endif
+
+namespace embedded_test {
+
+// Reflected IEEE 802.3 polynomial
+static const uint32_t kPolynomial = 0xEDB88320;
+
+// Below this the folding setup costs more than it saves
+static const size_t kPclmulMinimum = 64;
+
+// Smallest chunk handed to a thread by crc32_parallel
+static const size_t kParallelChunk = 1 << 20;
+
+// Read size for files that cannot be mapped (pipes, /proc)
+static const size_t kReadChunk = 1 << 20;
+
+// Multiply a and b modulo the polynomial, both as reflected 32-bit
+// polynomials where bit 31 is x^0 (zlib's multmodp)
+static uint32_t multmodp(uint32_t a, uint32_t b) {
+    uint32_t m = 1U << 31;
+    uint32_t product = 0;
+    for (;;) {
+        if (a & m) {
+            product ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ kPolynomial : b >> 1;
+    }
+    return product;
+}
+
+// table[0] is the classic byte table; table[k][b] is the CRC of byte b
+// followed by k zero bytes, so 16 bytes can be folded with 16 lookups
+struct Crc32Tables {
+    uint32_t table[16][256];
+    uint32_t x2n[32];
+
+    Crc32Tables() {
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t crc = b;
+            for (int i = 0; i < 8; i++) {
+                crc = (crc & 1) ? (crc >> 1) ^ kPolynomial : crc >> 1;
+            }
+            table[0][b] = crc;
+        }
+        for (uint32_t b = 0; b < 256; b++) {
+            for (int k = 1; k < 16; k++) {
+                uint32_t previous = table[k - 1][b];
+                table[k][b] = (previous >> 8) ^ table[0][previous & 0xFF];
+            }
+        }
+
+        // x^(2^n) mod P, starting from x^1
+        uint32_t power = 1U << 30;
+        x2n[0] = power;
+        for (int n = 1; n < 32; n++) {
+            power = multmodp(power, power);
+            x2n[n] = power;
+        }
+    }
+};
+
+static const Crc32Tables g_tables;
+
+static inline uint32_t load32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// All paths work on the inverted register; crc32_update does the inversion
+
+static uint32_t crc_bitwise(uint32_t crc, const uint8_t* p, size_t length) {
+    while (length--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 1) ? (crc >> 1) ^ kPolynomial : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t crc_bytes(uint32_t crc, const uint8_t* p, size_t length) {
+    const uint32_t (*t)[256] = g_tables.table;
+    while (length--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+static uint32_t crc_slice8(uint32_t crc, const uint8_t* p, size_t length) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint32_t (*t)[256] = g_tables.table;
+    while (length >= 8) {
+        uint32_t one = load32(p) ^ crc;
+        uint32_t two = load32(p + 4);
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^
+              t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^
+              t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+        p += 8;
+        length -= 8;
+    }
+#endif
+    return crc_bytes(crc, p, length);
+}
+
+static uint32_t crc_slice16(uint32_t crc, const uint8_t* p, size_t length) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const uint32_t (*t)[256] = g_tables.table;
+    while (length >= 16) {
+        uint32_t one = load32(p) ^ crc;
+        uint32_t two = load32(p + 4);
+        uint32_t three = load32(p + 8);
+        uint32_t four = load32(p + 12);
+        crc = t[15][one & 0xFF] ^ t[14][(one >> 8) & 0xFF] ^
+              t[13][(one >> 16) & 0xFF] ^ t[12][one >> 24] ^
+              t[11][two & 0xFF] ^ t[10][(two >> 8) & 0xFF] ^
+              t[9][(two >> 16) & 0xFF] ^ t[8][two >> 24] ^
+              t[7][three & 0xFF] ^ t[6][(three >> 8) & 0xFF] ^
+              t[5][(three >> 16) & 0xFF] ^ t[4][three >> 24] ^
+              t[3][four & 0xFF] ^ t[2][(four >> 8) & 0xFF] ^
+              t[1][(four >> 16) & 0xFF] ^ t[0][four >> 24];
+        p += 16;
+        length -= 16;
+    }
+#endif
+    return crc_slice8(crc, p, length);
+}
+
+#ifdef CRC32_HAVE_PCLMUL
+
+// Folding constants for the reflected polynomial (x^n mod P, bit-reversed),
+// from Intel's "Fast CRC Computation Using PCLMULQDQ Instruction"
+alignas(16) static const uint64_t kFold4[2] = {0x0154442bd4ULL, 0x01c6e41596ULL};
+alignas(16) static const uint64_t kFold1[2] = {0x01751997d0ULL, 0x00ccaa009eULL};
+alignas(16) static const uint64_t kFold64[2] = {0x0163cd6124ULL, 0x0000000000ULL};
+alignas(16) static const uint64_t kBarrett[2] = {0x01db710641ULL, 0x01f7011641ULL};
+
+// Folds four 128-bit lanes per 64 bytes, then reduces with Barrett.
+// length must be at least 64 and a multiple of 16
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc_pclmul_blocks(uint32_t crc, const uint8_t* p, size_t length) {
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(kFold4));
+    p += 64;
+    length -= 64;
+
+    while (length >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x30)));
+        p += 64;
+        length -= 64;
+    }
+
+    // Fold the four lanes into one
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(kFold1));
+    __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    while (length >= 16) {
+        x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        p += 16;
+        length -= 16;
+    }
+
+    // 128 bits down to 64
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kFold64));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(kBarrett));
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+static uint32_t crc_pclmul(uint32_t crc, const uint8_t* p, size_t length) {
+    if (length >= kPclmulMinimum) {
+        size_t blocks = length & ~static_cast<size_t>(15);
+        crc = crc_pclmul_blocks(crc, p, blocks);
+        p += blocks;
+        length -= blocks;
+    }
+    return crc_slice16(crc, p, length);
+}
+
+static bool cpu_has_pclmul() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+}
+
+#endif // CRC32_HAVE_PCLMUL
+
+typedef uint32_t (*CrcFunction)(uint32_t, const uint8_t*, size_t);
+
+static CrcFunction select_fastest() {
+#ifdef CRC32_HAVE_PCLMUL
+    if (cpu_has_pclmul()) {
+        return crc_pclmul;
+    }
+#endif
+    return crc_slice16;
+}
+
+uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t length, Crc32Path path) {
+    // Chosen once; every later call is one indirect jump
+    static const CrcFunction fastest = select_fastest();
+
+    crc = ~crc;
+    switch (path) {
+    case Crc32Path::BITWISE:
+        crc = crc_bitwise(crc, data, length);
+        break;
+    case Crc32Path::SLICE_BY_8:
+        crc = crc_slice8(crc, data, length);
+        break;
+    case Crc32Path::SLICE_BY_16:
+        crc = crc_slice16(crc, data, length);
+        break;
+    case Crc32Path::PCLMUL:
+#ifdef CRC32_HAVE_PCLMUL
+        if (crc32_path_available(Crc32Path::PCLMUL)) {
+            crc = crc_pclmul(crc, data, length);
+            break;
+        }
+#endif
+        crc = crc_slice16(crc, data, length);
+        break;
+    case Crc32Path::AUTO:
+    default:
+        crc = fastest(crc, data, length);
+        break;
+    }
+    return ~crc;
+}
+
+// x^(n * 2^k) mod P
+static uint32_t x2nmodp(uint64_t n, unsigned k) {
+    uint32_t power = 1U << 31;
+    while (n) {
+        if (n & 1) {
+            power = multmodp(g_tables.x2n[k & 31], power);
+        }
+        n >>= 1;
+        k++;
+    }
+    return power;
+}
+
+uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t length2) {
+    // Shift crc1 past length2 zero bytes, then add crc2
+    return multmodp(x2nmodp(length2, 3), crc1) ^ crc2;
+}
+
+uint32_t crc32_parallel(uint32_t crc, const uint8_t* data, size_t length, unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    size_t chunks = std::min<size_t>(threads, length / kParallelChunk);
+    if (chunks <= 1) {
+        return crc32_update(crc, data, length);
+    }
+
+    // Chunk 0 runs here and continues from crc; the rest start from 0
+    size_t chunk_size = length / chunks;
+    std::vector<uint32_t> results(chunks, 0);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (size_t i = 1; i < chunks; i++) {
+        const uint8_t* begin = data + i * chunk_size;
+        size_t size = i + 1 == chunks ? length - i * chunk_size : chunk_size;
+        workers.emplace_back([&results, i, begin, size]() {
+            results[i] = crc32_update(0, begin, size);
+        });
+    }
+    results[0] = crc32_update(crc, data, chunk_size);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    crc = results[0];
+    for (size_t i = 1; i < chunks; i++) {
+        size_t size = i + 1 == chunks ? length - i * chunk_size : chunk_size;
+        crc = crc32_combine(crc, results[i], size);
+    }
+    return crc;
+}
+
+void Crc32Stream::update(const uint8_t* data, size_t length, unsigned threads) {
+    crc_ = threads == 1 ? crc32_update(crc_, data, length)
+                        : crc32_parallel(crc_, data, length, threads);
+    length_ += length;
+}
+
+bool Crc32Stream::update_file(const std::string& path, unsigned threads) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Cannot open " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        size_t size = static_cast<size_t>(st.st_size);
+        if (size == 0) {
+            ::close(fd);
+            return true;
+        }
+        void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            ::close(fd);
+            madvise(map, size, MADV_SEQUENTIAL);
+            madvise(map, size, MADV_WILLNEED);
+            update(static_cast<const uint8_t*>(map), size, threads);
+            munmap(map, size);
+            return true;
+        }
+    }
+
+    // Not mappable: read it through in chunks on this thread
+    Crc32Stream piece;
+    std::vector<uint8_t> buffer(kReadChunk);
+    for (;;) {
+        ssize_t got = read(fd, buffer.data(), buffer.size());
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Cannot read " << path << ": " << strerror(errno) << std::endl;
+            ::close(fd);
+            return false;
+        }
+        if (got == 0) {
+            break;
+        }
+        piece.update(buffer.data(), static_cast<size_t>(got));
+    }
+    ::close(fd);
+    append(piece);
+    return true;
+}
+
+void Crc32Stream::append(const Crc32Stream& next) {
+    crc_ = crc32_combine(crc_, next.crc_, next.length_);
+    length_ += next.length_;
+}
+
+bool crc32_path_available(Crc32Path path) {
+    if (path != Crc32Path::PCLMUL) {
+        return true;
+    }
+#ifdef CRC32_HAVE_PCLMUL
+    static const bool supported = cpu_has_pclmul();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+const char* crc32_path_name(Crc32Path path) {
+    switch (path) {
+    case Crc32Path::BITWISE:
+        return "bitwise";
+    case Crc32Path::SLICE_BY_8:
+        return "slice-by-8";
+    case Crc32Path::SLICE_BY_16:
+        return "slice-by-16";
+    case Crc32Path::PCLMUL:
+        return "pclmul";
+    case Crc32Path::AUTO:
+    default:
+        return "auto";
+    }
+}
+
+} // namespace embedded_test
@@ -0,0 +1,123 @@
+/**================================================================================
+* FILE: crc32.h
+
+* Purpose:
+* 1. CRC-32 (IEEE 802.3, as used by zlib and the Ethernet FCS)
+* 2. Slicing-by-8/16 tables and a PCLMULQDQ folding path chosen at runtime
+* 3. Streaming state, crc32_combine and multi-threaded checksums of large inputs
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace embedded_test {
+
+//CRC-32 implementation to use
+
+enum class Crc32Path {
+    AUTO,           // fastest path this CPU supports
+    BITWISE,        // reference, one bit per step
+    SLICE_BY_8,     // 8 table lookups per 8 bytes
+    SLICE_BY_16,    // 16 table lookups per 16 bytes
+    PCLMUL          // carry-less multiply folding (x86 PCLMULQDQ + SSE4.1)
+};
+
+//Continue a CRC-32 over more data
+//Same convention as zlib's crc32(): start from 0, pass the previous result
+//to continue, so crc32_update(crc32_update(0, a), b) == crc of a then b
+//param crc Result so far (0 for a new checksum)
+//param data Bytes to add
+//param length Number of bytes
+//param path Implementation (AUTO unless benchmarking)
+//return Updated CRC-32
+
+uint32_t crc32_update(uint32_t crc, const uint8_t* data, size_t length,
+                      Crc32Path path = Crc32Path::AUTO);
+
+//CRC of two pieces joined together, from the CRC of each (zlib crc32_combine)
+//Lets chunks of one buffer be checksummed on separate threads
+//param crc1 CRC-32 of the first piece
+//param crc2 CRC-32 of the second piece
+//param length2 Length of the second piece in bytes
+//return CRC-32 of the first piece followed by the second
+
+uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t length2);
+
+//crc32_update split across threads and merged with crc32_combine
+//Buffers too small to be worth a thread are done on the caller's thread
+//param crc Result so far (0 for a new checksum)
+//param data Bytes to add
+//param length Number of bytes
+//param threads Worker count, 0 = one per CPU
+//return Updated CRC-32
+
+uint32_t crc32_parallel(uint32_t crc, const uint8_t* data, size_t length, unsigned threads = 0);
+
+//Check whether a path can run on this CPU
+//param path Implementation
+//return true if supported
+
+bool crc32_path_available(Crc32Path path);
+
+//Name of a path for reports
+//param path Implementation
+//return Short name ("pclmul", "slice-by-16", ...)
+
+const char* crc32_path_name(Crc32Path path);
+
+//Incremental CRC-32 over data that arrives in pieces
+//Feed chunks of any size in order with update(), or whole files with
+//update_file(), and read the result with finalize(). Streams built
+//independently (e.g. one per thread) are joined with append()
+
+class Crc32Stream {
+public:
+    Crc32Stream() : crc_(0), length_(0) {}
+
+    //Start over
+    void reset() {
+        crc_ = 0;
+        length_ = 0;
+    }
+
+    //Add the next chunk
+    //param data Bytes to add
+    //param length Number of bytes
+    //param threads Workers for this chunk, 0 = one per CPU
+
+    void update(const uint8_t* data, size_t length, unsigned threads = 1);
+
+    //Add the contents of a file, memory-mapped rather than read into a buffer
+    //param path File to add
+    //param threads Workers, 0 = one per CPU
+    //return false if the file cannot be read (stream is unchanged)
+
+    bool update_file(const std::string& path, unsigned threads = 0);
+
+    //Add everything another stream has seen, as if its data followed ours
+    //param next Stream over the data that comes after
+
+    void append(const Crc32Stream& next);
+
+    //CRC-32 of everything added so far (the stream can keep going)
+    uint32_t finalize() const { return crc_; }
+
+    //Bytes added so far
+    uint64_t length() const { return length_; }
+
+private:
+    uint32_t crc_;
+    uint64_t length_;
+};
+
+} // namespace embedded_test
+
+#endif // CRC32_H
@@ -0,0 +1,273 @@
+/**================================================================================
+* FILE: fanout_group.cpp
+
+* Purpose:
+* 1. Implementation of the PACKET_FANOUT receive group
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "fanout_group.h"
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+#include <poll.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace embedded_test {
+
+// Frames taken from a socket per queue lock
+static const int kWorkerBurst = 64;
+
+// Queued frames kept per worker unless overridden
+static const size_t kDefaultQueueLimit = 65536;
+
+// Most frames dropped from a socket's private copy before it joins; on a
+// busy link the copy never runs dry, so start() must not wait for that
+static const int kJoinDrainLimit = 65536;
+
+FanoutGroup::FanoutGroup(const std::string& interface_name, const FanoutConfig& config)
+    : interface_name_(interface_name),
+      config_(config),
+      running_(false),
+      queue_limit_(kDefaultQueueLimit) {
+    if (config_.workers == 0) {
+        config_.workers = 1;
+    }
+}
+
+FanoutGroup::~FanoutGroup() {
+    stop();
+}
+
+bool FanoutGroup::start(FrameHandler handler) {
+    if (running_.load()) {
+        return true;
+    }
+
+    if (config_.rx_mode == RxMode::XDP) {
+        std::cerr << "PACKET_FANOUT needs SOCKET or MMAP_RING receive" << std::endl;
+        return false;
+    }
+
+    // 0 until the first socket joins and the kernel hands out a free id
+    uint16_t group_id = config_.group_id;
+
+    workers_.clear();
+    handler_ = handler;
+
+    for (uint32_t i = 0; i < config_.workers; i++) {
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->cpu = (i < config_.cpus.size()) ? config_.cpus[i] : static_cast<int>(i);
+        worker->comms.reset(new FastComms(interface_name_, config_.timeout_ms));
+
+        if (!config_.filter.empty() && !worker->comms->set_filter(config_.filter)) {
+            workers_.clear();
+            return false;
+        }
+
+        if (!worker->comms->initialize(TxMode::SOCKET, config_.rx_mode)) {
+            workers_.clear();
+            return false;
+        }
+
+        // Until it joins, the socket gets a copy of the whole stream; drop
+        // that copy first, so nothing dropped was meant for the group
+        PacketView view;
+        for (int dropped = 0; dropped < kJoinDrainLimit && worker->comms->try_receive(view) > 0;
+             dropped++) {
+        }
+        worker->comms->reset_statistics();
+
+        if (!join_group(*worker->comms, group_id)) {
+            workers_.clear();
+            return false;
+        }
+
+        workers_.push_back(std::move(worker));
+    }
+
+    running_.store(true);
+    for (size_t i = 0; i < workers_.size(); i++) {
+        workers_[i]->thread = std::thread(&FanoutGroup::run_worker, this, i);
+    }
+
+    return true;
+}
+
+void FanoutGroup::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+        worker->comms->close();
+    }
+}
+
+size_t FanoutGroup::drain(ReactorBatch& out) {
+    out.clear();
+
+    for (auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->queue_mutex);
+        const ReactorBatch& queue = worker->queue;
+        if (queue.count() == 0) {
+            continue;
+        }
+
+        uint32_t base = static_cast<uint32_t>(out.buffer.size());
+        out.buffer.insert(out.buffer.end(), queue.buffer.begin(), queue.buffer.end());
+        for (uint32_t offset : queue.offsets) {
+            out.offsets.push_back(base + offset);
+        }
+        out.lengths.insert(out.lengths.end(), queue.lengths.begin(), queue.lengths.end());
+        out.channels.insert(out.channels.end(), queue.channels.begin(), queue.channels.end());
+        out.timestamps_ns.insert(out.timestamps_ns.end(), queue.timestamps_ns.begin(),
+                                 queue.timestamps_ns.end());
+        worker->queue.clear();
+    }
+
+    return out.count();
+}
+
+void FanoutGroup::set_queue_limit(size_t max_frames) {
+    queue_limit_.store(max_frames);
+}
+
+PacketStats FanoutGroup::get_statistics() const {
+    PacketStats total;
+    double latency_weight = 0.0;
+
+    for (const auto& worker : workers_) {
+        PacketStats stats = worker->comms->get_statistics();
+        total.packets_sent += stats.packets_sent;
+        total.packets_received += stats.packets_received;
+        total.bytes_sent += stats.bytes_sent;
+        total.bytes_received += stats.bytes_received;
+        total.errors += stats.errors;
+        total.kernel_drops += stats.kernel_drops;
+        total.avg_latency_us += stats.avg_latency_us * stats.packets_sent;
+        latency_weight += stats.packets_sent;
+        total.latency.add(stats.latency);
+    }
+
+    if (latency_weight > 0) {
+        total.avg_latency_us /= latency_weight;
+    }
+
+    return total;
+}
+
+PacketStats FanoutGroup::get_worker_statistics(size_t worker) const {
+    if (worker >= workers_.size()) {
+        return PacketStats();
+    }
+    return workers_[worker]->comms->get_statistics();
+}
+
+uint64_t FanoutGroup::get_queue_drops() const {
+    uint64_t drops = 0;
+    for (const auto& worker : workers_) {
+        drops += worker->queue_drops.load(std::memory_order_relaxed);
+    }
+    return drops;
+}
+
+// Private helper methods
+
+bool FanoutGroup::join_group(FastComms& comms, uint16_t& group_id) {
+    int type = PACKET_FANOUT_HASH;
+    if (config_.mode == FanoutMode::CPU) {
+        type = PACKET_FANOUT_CPU;
+    } else if (config_.mode == FanoutMode::ROUND_ROBIN) {
+        type = PACKET_FANOUT_LB;
+    } else {
+        // Hash the reassembled datagram so fragments stay with their flow
+        type |= PACKET_FANOUT_FLAG_DEFRAG;
+    }
+
+    // Group ids are shared by every process in the network namespace, so
+    // let the kernel pick one nobody uses instead of guessing
+    bool unique = (group_id == 0);
+    if (unique) {
+        type |= PACKET_FANOUT_FLAG_UNIQUEID;
+    }
+
+    int arg = group_id | (type << 16);
+    if (setsockopt(comms.get_fd(), SOL_PACKET, PACKET_FANOUT, &arg, sizeof(arg)) < 0) {
+        if (unique) {
+            std::cerr << "Failed to create a fanout group (needs Linux 4.20, "
+                      << "or set group_id): " << strerror(errno) << std::endl;
+        } else {
+            std::cerr << "Failed to join fanout group " << group_id << ": "
+                      << strerror(errno) << std::endl;
+        }
+        return false;
+    }
+
+    if (unique) {
+        socklen_t len = sizeof(arg);
+        if (getsockopt(comms.get_fd(), SOL_PACKET, PACKET_FANOUT, &arg, &len) < 0) {
+            std::cerr << "Failed to read fanout group id: " << strerror(errno) << std::endl;
+            return false;
+        }
+        group_id = static_cast<uint16_t>(arg & 0xFFFF);
+    }
+    return true;
+}
+
+void FanoutGroup::run_worker(size_t index) {
+    Worker& worker = *workers_[index];
+    FastComms& comms = *worker.comms;
+    int channel_id = static_cast<int>(index);
+
+    pin_thread_to_cpu(worker.cpu);
+
+    PacketView view;
+    while (running_.load(std::memory_order_relaxed)) {
+        int taken = 0;
+
+        if (handler_) {
+            while (taken < kWorkerBurst && comms.try_receive(view) > 0) {
+                handler_(channel_id, view);
+                taken++;
+            }
+        } else {
+            std::lock_guard<std::mutex> lock(worker.queue_mutex);
+            ReactorBatch& queue = worker.queue;
+            size_t limit = queue_limit_.load(std::memory_order_relaxed);
+
+            while (taken < kWorkerBurst && comms.try_receive(view) > 0) {
+                taken++;
+                if (queue.count() >= limit) {
+                    worker.queue_drops.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                queue.offsets.push_back(static_cast<uint32_t>(queue.buffer.size()));
+                queue.lengths.push_back(view.length);
+                queue.channels.push_back(channel_id);
+                queue.timestamps_ns.push_back(view.timestamp_ns);
+                queue.buffer.insert(queue.buffer.end(), view.data, view.data + view.length);
+            }
+        }
+
+        if (taken > 0) {
+            continue;
+        }
+
+        // Idle: sleep until the socket has frames or it is time to check stop
+        struct pollfd pfd;
+        pfd.fd = comms.get_fd();
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        poll(&pfd, 1, static_cast<int>(config_.timeout_ms));
+    }
+}
+
+} // namespace embedded_test
@@ -0,0 +1,135 @@
+/**================================================================================
+* FILE: fanout_group.h
+
+* Purpose:
+* 1. Multi-threaded receive: one socket per worker joined with PACKET_FANOUT
+* 2. Workers pinned to cores, statistics merged across workers
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef FANOUT_GROUP_H
+#define FANOUT_GROUP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fast_comms.h"
+#include "comms_reactor.h"
+
+namespace embedded_test {
+
+//How the kernel spreads frames over the workers
+
+enum class FanoutMode {
+    HASH,           // by flow hash; one flow always lands on one worker
+    CPU,            // by the CPU that received the frame
+    ROUND_ROBIN     // frame by frame, no ordering guarantee
+};
+
+//Fanout group settings
+
+struct FanoutConfig {
+    uint32_t workers;           // receive threads (one socket each)
+    FanoutMode mode;
+    RxMode rx_mode;             // SOCKET or MMAP_RING
+    std::vector<int> cpus;      // CPU per worker; empty pins worker i to CPU i
+    uint16_t group_id;          // 0 has the kernel pick an unused id
+    uint32_t timeout_ms;        // longest idle wait before re-checking stop
+    std::string filter;         // kernel filter for every socket (see PacketFilter)
+
+    FanoutConfig() : workers(4), mode(FanoutMode::HASH), rx_mode(RxMode::MMAP_RING),
+                     group_id(0), timeout_ms(100) {}
+};
+
+//Receive group spreading one interface's traffic over pinned workers
+//Each worker owns a FastComms socket; the kernel picks the socket per
+//frame. Frames go to the handler on the worker's thread, or into a
+//per-worker queue that drain() collects. In HASH mode every flow stays
+//on one worker, so per-flow order (and sequence checks) is preserved
+
+class FanoutGroup {
+public:
+    //param interface_name Network interface (e.g., "eth0")
+    //param config Workers, mode and pinning
+
+    FanoutGroup(const std::string& interface_name, const FanoutConfig& config = FanoutConfig());
+    ~FanoutGroup();
+
+    FanoutGroup(const FanoutGroup&) = delete;
+    FanoutGroup& operator=(const FanoutGroup&) = delete;
+
+    //Open the sockets, join the fanout group and start the workers
+    //param handler Called on the worker thread with the worker index as
+    //channel_id; must be thread-safe. Frames are queued for drain() if empty
+    //return true if every worker started
+
+    bool start(FrameHandler handler = FrameHandler());
+
+    //Stop and join the workers, then close their sockets
+
+    void stop();
+
+    bool is_running() const { return running_.load(); }
+
+    size_t worker_count() const { return workers_.size(); }
+
+    //Move queued frames from every worker into out
+    //Frames of one worker stay in arrival order; channels holds the worker
+    //param out Receives the frames (its storage is recycled)
+    //return Number of frames moved
+
+    size_t drain(ReactorBatch& out);
+
+    //Cap on queued frames per worker; further frames count as queue drops
+    //param max_frames Maximum queue length
+
+    void set_queue_limit(size_t max_frames);
+
+    //Counters summed over all workers
+
+    PacketStats get_statistics() const;
+
+    //Counters of one worker
+    //param worker Worker index
+
+    PacketStats get_worker_statistics(size_t worker) const;
+
+    //Frames discarded because a worker queue was full
+
+    uint64_t get_queue_drops() const;
+
+private:
+    struct Worker {
+        std::unique_ptr<FastComms> comms;
+        std::thread thread;
+        int cpu;
+        std::mutex queue_mutex;
+        ReactorBatch queue;
+        std::atomic<uint64_t> queue_drops;
+
+        Worker() : cpu(0), queue_drops(0) {}
+    };
+
+    std::string interface_name_;
+    FanoutConfig config_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    FrameHandler handler_;
+    std::atomic<bool> running_;
+    std::atomic<size_t> queue_limit_;
+
+    // Helper methods
+    bool join_group(FastComms& comms, uint16_t& group_id);
+    void run_worker(size_t index);
+};
+
+} // namespace embedded_test
+
+#endif // FANOUT_GROUP_H
@@ -10,30 +10,109 @@
 ================================================================================
 */
 #include "fast_comms.h"
+#include "crc32.h"
+#include "inet_checksum.h"
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <net/if.h>
 #include <linux/if_packet.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
+#include <linux/errqueue.h>
 #include <net/ethernet.h>
+#include <arpa/inet.h>
 #include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cerrno>
 #include <cstring>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 #include <stdexcept>
 #include <iostream>
 
 namespace embedded_test {
 
+// Frames queued in the TX ring between kicks during stress_test
+static const uint32_t kRingKickBatch = 256;
+
+// Frames per sendmmsg() call in SENDMMSG mode unless overridden
+static const uint32_t kDefaultSendBatch = 64;
+
+// Submission queue depth of the io_uring engine
+static const uint32_t kUringDepth = 256;
+
+// Receive buffer per in-flight send_and_receive_batch transaction
+static const size_t kUringRecvSize = 4096;
+
+// io_uring user_data carries the call's tag above this bit and the
+// frame or slot below it
+static const int kUringTagShift = 48;
+static const uint64_t kUringIndexMask = (1ULL << kUringTagShift) - 1;
+
+// Per-frame control buffer for the SO_TIMESTAMPNS and SO_TIMESTAMPING cmsgs
+static const size_t kRxControlSize = CMSG_SPACE(sizeof(struct timespec)) +
+                                     CMSG_SPACE(sizeof(struct scm_timestamping));
+
+// How long send_and_receive waits for the TX timestamp of its request
+static const int kTxTimestampWaitMs = 5;
+
+// Largest frame try_receive() and the pipelined receive path take
+static const size_t kScratchFrameSize = 65536;
+
+// try_receive() copies frames here, so a view cannot be recycled by a
+// receive on another thread
+static thread_local std::vector<uint8_t> t_receive_buffer;
+
+bool pin_thread_to_cpu(int cpu) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus <= 0) {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(cpu % cpus), &set);
+
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        std::cerr << "Warning: Failed to pin thread to CPU " << cpu << ": "
+                  << strerror(rc) << std::endl;
+        return false;
+    }
+    return true;
+}
+
 FastComms::FastComms(const std::string& interface_name, uint32_t timeout_ms)
     : interface_name_(interface_name),
       timeout_ms_(timeout_ms),
       socket_fd_(-1),
-      initialized_(false) {
+      initialized_(false),
+      kernel_drops_(0),
+      tx_mode_(TxMode::SOCKET),
+      rx_mode_(RxMode::SOCKET),
+      uring_attempted_(false),
+      uring_call_(0),
+      tx_batch_size_(kDefaultSendBatch),
+      rx_timestamps_enabled_(false),
+      view_owner_warned_(false),
+      timestamping_(false),
+      hardware_requested_(false),
+      hardware_timestamps_(false),
+      capture_transmit_(false),
+      qdisc_bypass_(false),
+      transmit_only_(false),
+      stress_stop_(false) {
 }
 
 FastComms::~FastComms() {
     close();
 }
 
-bool FastComms::initialize() {
+bool FastComms::initialize(TxMode tx_mode, RxMode rx_mode) {
     if (initialized_) {
         return true;
     }
@@ -44,6 +123,12 @@ bool FastComms::initialize() {
         return false;
     }
     
+    // The socket receives nothing until bind() names the protocol, so a
+    // filter attached now sees every frame that will ever be queued
+    if (!filter_.matches_all() && !filter_.attach(socket_fd_)) {
+        std::cerr << "Warning: Receiving unfiltered traffic" << std::endl;
+    }
+    
     // Bind to interface
     if (bind_to_interface() < 0) {
         ::close(socket_fd_);
@@ -60,271 +145,2245 @@ bool FastComms::initialize() {
         std::cerr << "Warning: Failed to set receive timeout" << std::endl;
     }
     
+    tx_mode_ = TxMode::SOCKET;
+    rx_mode_ = RxMode::SOCKET;
+    
+    // AF_XDP socket next to the raw socket, which stays as the fallback
+    bool want_tx_xdp = (tx_mode == TxMode::XDP);
+    bool want_rx_xdp = (rx_mode == RxMode::XDP);
+    
+    if (want_tx_xdp || want_rx_xdp) {
+        if (xsk_.open(interface_name_, xdp_config_, want_tx_xdp, want_rx_xdp)) {
+            if (want_tx_xdp) {
+                tx_mode_ = TxMode::XDP;
+            }
+            if (want_rx_xdp) {
+                rx_mode_ = RxMode::XDP;
+            }
+        } else {
+            std::cerr << "Warning: AF_XDP unavailable, using raw socket" << std::endl;
+        }
+    }
+    
+    // Map the packet rings if requested
+    bool want_tx_ring = (tx_mode == TxMode::MMAP_RING);
+    bool want_rx_ring = (rx_mode == RxMode::MMAP_RING);
+    
+    if (want_tx_ring || want_rx_ring) {
+        if (setup_rings(want_tx_ring, want_rx_ring)) {
+            if (want_tx_ring) {
+                tx_mode_ = TxMode::MMAP_RING;
+            }
+            if (want_rx_ring) {
+                rx_mode_ = RxMode::MMAP_RING;
+            }
+        } else {
+            std::cerr << "Warning: Packet rings unavailable, using socket send/recv" << std::endl;
+        }
+    }
+    
+    if (tx_mode == TxMode::SENDMMSG) {
+        tx_mode_ = TxMode::SENDMMSG;
+    }
+    
+    if (tx_mode == TxMode::IO_URING) {
+        if (uring_ready()) {
+            tx_mode_ = TxMode::IO_URING;
+        } else {
+            std::cerr << "Warning: io_uring unavailable, using socket send" << std::endl;
+        }
+    }
+    
+    if (timestamping_ && !apply_timestamping()) {
+        std::cerr << "Warning: Kernel timestamps unavailable, using user-space clock" << std::endl;
+    }
+    
     initialized_ = true;
     return true;
 }
 
 void FastComms::close() {
+    if (socket_fd_ >= 0) {
+        collect_kernel_drops();
+    }
+    
+    ring_.release();
+    xsk_.close();
+    uring_.close();
+    uring_attempted_ = false;
+    
     if (socket_fd_ >= 0) {
         ::close(socket_fd_);
         socket_fd_ = -1;
     }
     initialized_ = false;
+    rx_timestamps_enabled_ = false;
+    view_owner_ = std::thread::id();
+    view_owner_warned_ = false;
 }
 
-bool FastComms::send_packet(const std::vector<uint8_t>& data) {
+bool FastComms::send_packet(ByteSpan data) {
     if (!initialized_ || socket_fd_ < 0) {
         return false;
     }
     
     uint64_t start_time = get_timestamp_us();
     
+    if (tx_mode_ == TxMode::MMAP_RING) {
+        std::lock_guard<std::mutex> lock(tx_mutex_);
+        if (!ring_.tx_enqueue(data.data(), data.size()) || ring_.tx_flush(false) < 0) {
+            count_errors(1);
+            return false;
+        }
+        update_stats(true, data.size(), get_timestamp_us() - start_time);
+        capture_tx(data);
+        return true;
+    }
+    
+    if (tx_mode_ == TxMode::XDP) {
+        std::lock_guard<std::mutex> lock(xdp_mutex_);
+        if (!xsk_.send(data.data(), data.size()) || xsk_.kick() < 0) {
+            count_errors(1);
+            return false;
+        }
+        update_stats(true, data.size(), get_timestamp_us() - start_time);
+        capture_tx(data);
+        return true;
+    }
+    
     ssize_t sent = send(socket_fd_, data.data(), data.size(), 0);
     
     if (sent < 0) {
-        stats_.errors++;
+        count_errors(1);
         return false;
     }
     
     uint64_t latency = get_timestamp_us() - start_time;
     update_stats(true, sent, latency);
+    capture_tx(data);
     
     return sent == static_cast<ssize_t>(data.size());
 }
 
 int FastComms::receive_packet(std::vector<uint8_t>& buffer, size_t max_size) {
-    if (!initialized_ || socket_fd_ < 0) {
-        return -1;
-    }
-    
     buffer.resize(max_size);
     
-    ssize_t received = recv(socket_fd_, buffer.data(), max_size, 0);
+    PacketView frame;
+    int received = receive_into(buffer.data(), max_size, frame, false);
     
-    if (received < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            
-            return 0;
-        }
-        stats_.errors++;
+    buffer.resize(received > 0 ? received : 0);
+    return received;
+}
+
+int FastComms::receive_packet(PacketBuffer& buffer) {
+    if (!buffer.valid()) {
         return -1;
     }
     
-    buffer.resize(received);
-    update_stats(false, received, 0);
+    PacketView frame;
+    int received = receive_into(buffer.data(), buffer.capacity(), frame, false);
     
+    buffer.set_size(received > 0 ? received : 0);
+    buffer.set_timestamp_ns(frame.timestamp_ns);
     return received;
 }
 
-CommResult FastComms::send_and_receive(const std::vector<uint8_t>& request,
-                                       std::vector<uint8_t>& response) {
-    CommResult result;
+int FastComms::receive_view(PacketView& view) {
+    if (!initialized_ || !in_place_rx()) {
+        return -1;
+    }
     
-    uint64_t start_time = get_timestamp_us();
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    if (!check_view_owner()) {
+        return -1;
+    }
+    view_owner_ = std::this_thread::get_id();
     
-    // Send request
-    if (!send_packet(request)) {
-        result.error_message = "Failed to send request";
-        return result;
+    int ready = next_view(view, timeout_ms_);
+    if (ready <= 0) {
+        return ready;
     }
     
-    // Receive response
-    int received = receive_packet(response);
+    update_stats(false, view.length, 0);
+    capture_rx(view);
     
-    if (received < 0) {
-        result.error_message = "Failed to receive response";
-        return result;
+    return static_cast<int>(view.length);
+}
+
+int FastComms::receive_batch(ReceiveBatch& batch, size_t max_frames,
+                             uint32_t timeout_ms, size_t max_frame_size) {
+    batch.lengths.clear();
+    batch.timestamps_ns.clear();
+    
+    if (!initialized_ || socket_fd_ < 0) {
+        return -1;
+    }
+    if (max_frames == 0 || max_frame_size == 0) {
+        return 0;
     }
     
-    if (received == 0) {
-        result.error_message = "Response timeout";
-        return result;
+    // Reuses the caller's storage when the geometry has not changed
+    batch.slot_size = max_frame_size;
+    if (batch.buffer.size() < max_frames * max_frame_size) {
+        batch.buffer.resize(max_frames * max_frame_size);
     }
     
-    result.success = true;
-    result.data = response;
-    result.latency_us = get_timestamp_us() - start_time;
+    uint64_t bytes = 0;
     
-    return result;
+    if (in_place_rx()) {
+        std::lock_guard<std::mutex> lock(rx_mutex_);
+        if (!check_view_owner()) {
+            return -1;
+        }
+        PacketView view;
+        int ready = next_view(view, timeout_ms);
+        if (ready <= 0) {
+            return ready;
+        }
+        
+        // Drain what the ring already holds, one copy per frame
+        do {
+            size_t copy_len = std::min<size_t>(view.length, max_frame_size);
+            memcpy(batch.buffer.data() + batch.lengths.size() * max_frame_size,
+                   view.data, copy_len);
+            batch.lengths.push_back(static_cast<uint32_t>(copy_len));
+            batch.timestamps_ns.push_back(view.timestamp_ns);
+            bytes += view.length;
+            capture_rx(view);
+        } while (batch.lengths.size() < max_frames && poll_view(view));
+    } else {
+        // Wait without the lock so other receivers are not held up
+        int ready = wait_readable(timeout_ms);
+        if (ready <= 0) {
+            return ready;
+        }
+        
+        std::lock_guard<std::mutex> lock(rx_mutex_);
+        enable_rx_timestamps();
+        prepare_rx_batch(batch, max_frames);
+        
+        int received = recvmmsg(socket_fd_, rx_msgs_.data(), max_frames, MSG_DONTWAIT, nullptr);
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                return 0;
+            }
+            count_errors(1);
+            return -1;
+        }
+        
+        uint64_t fallback_ns = get_timestamp_us() * 1000;
+        for (int i = 0; i < received; i++) {
+            batch.lengths.push_back(static_cast<uint32_t>(std::min<size_t>(rx_msgs_[i].msg_len, max_frame_size)));
+            batch.timestamps_ns.push_back(rx_timestamp_ns(rx_msgs_[i].msg_hdr, fallback_ns));
+            bytes += rx_msgs_[i].msg_len;
+            
+            if (capture_) {
+                PacketView view;
+                view.data = batch.buffer.data() + i * max_frame_size;
+                view.length = batch.lengths.back();
+                view.timestamp_ns = batch.timestamps_ns.back();
+                view.outgoing = (rx_addrs_[i].sll_pkttype == PACKET_OUTGOING);
+                capture_rx(view);
+            }
+        }
+    }
+    
+    count_received(batch.lengths.size(), bytes);
+    
+    return static_cast<int>(batch.lengths.size());
 }
 
-int FastComms::burst_send(const std::vector<std::vector<uint8_t>>& packets) {
-    int sent_count = 0;
+int FastComms::try_receive(PacketView& view) {
+    if (!initialized_ || socket_fd_ < 0) {
+        return -1;
+    }
     
-    for (const auto& packet : packets) {
-        if (send_packet(packet)) {
-            sent_count++;
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    
+    if (in_place_rx()) {
+        if (!check_view_owner()) {
+            return -1;
+        }
+        PacketView slot;
+        if (!poll_view(slot)) {
+            return 0;
+        }
+        update_stats(false, slot.length, 0);
+        capture_rx(slot);
+        
+        // Copied before the lock is dropped; another receiver may recycle the slot
+        if (t_receive_buffer.size() < slot.length) {
+            t_receive_buffer.resize(std::max<size_t>(slot.length, kScratchFrameSize));
         }
+        memcpy(t_receive_buffer.data(), slot.data, slot.length);
+        view = slot;
+        view.data = t_receive_buffer.data();
+        return static_cast<int>(view.length);
     }
     
-    return sent_count;
+    int received = read_socket_frame(view, t_receive_buffer);
+    if (received > 0) {
+        update_stats(false, received, 0);
+        capture_rx(view);
+    }
+    
+    return received;
 }
 
-int64_t FastComms::measure_latency(const std::vector<uint8_t>& payload) {
-    std::vector<uint8_t> response;
-    CommResult result = send_and_receive(payload, response);
+CommResult FastComms::send_and_receive(ByteSpan request, std::vector<uint8_t>& response) {
+    CommResult result;
+    
+    response.resize(4096);
+    int received = exchange(request, response.data(), response.size(), result);
+    response.resize(received > 0 ? received : 0);
     
     if (result.success) {
-        return result.latency_us;
+        result.data = response;
     }
     
-    return -1;
+    return result;
 }
 
-PacketStats FastComms::stress_test(uint32_t duration_ms, size_t packet_size) {
-    PacketStats test_stats;
-    
-    // Create test packet
-    std::vector<uint8_t> test_packet(packet_size, 0xAA);
-    
-    uint64_t start_time = get_timestamp_us();
-    uint64_t end_time = start_time + (duration_ms * 1000);
+CommResult FastComms::send_and_receive(ByteSpan request, PacketBuffer& response) {
+    CommResult result;
     
-    while (get_timestamp_us() < end_time) {
-        if (send_packet(test_packet)) {
-            test_stats.packets_sent++;
-            test_stats.bytes_sent += packet_size;
-        } else {
-            test_stats.errors++;
-        }
+    if (!response.valid()) {
+        result.error_message = "Failed to receive response";
+        return result;
     }
     
-    uint64_t total_time_us = get_timestamp_us() - start_time;
-    
-    // Calculate throughput
-    if (total_time_us > 0) {
-        double time_sec = total_time_us / 1000000.0;
-        double mbps = (test_stats.bytes_sent * 8.0) / (time_sec * 1000000.0);
-        std::cout << "Stress test: " << test_stats.packets_sent 
-                  << " packets, " << mbps << " Mbps" << std::endl;
-    }
+    int received = exchange(request, response.data(), response.capacity(), result);
+    response.set_size(received > 0 ? received : 0);
+    response.set_timestamp_ns(result.rx_timestamp_ns);
     
-    return test_stats;
-}
-
-PacketStats FastComms::get_statistics() const {
-    return stats_;
+    return result;
 }
 
-void FastComms::reset_statistics() {
-    stats_ = PacketStats();
+int FastComms::burst_send(const std::vector<std::vector<uint8_t>>& packets) {
+    std::vector<ByteSpan> spans(packets.begin(), packets.end());
+    return burst_send(spans);
 }
 
-void FastComms::set_timeout(uint32_t timeout_ms) {
-    timeout_ms_ = timeout_ms;
-    
-    if (initialized_ && socket_fd_ >= 0) {
-        struct timeval tv;
-        tv.tv_sec = timeout_ms_ / 1000;
-        tv.tv_usec = (timeout_ms_ % 1000) * 1000;
-        setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+int FastComms::burst_send(const std::vector<ByteSpan>& packets) {
+    if (tx_mode_ == TxMode::MMAP_RING) {
+        return ring_burst_send(packets, nullptr);
+    }
+    if (tx_mode_ == TxMode::SENDMMSG) {
+        return batched_burst_send(packets, nullptr);
     }
+    if (tx_mode_ == TxMode::XDP) {
+        return xdp_burst_send(packets, nullptr);
+    }
+    if (tx_mode_ == TxMode::IO_URING) {
+        return uring_burst_send(packets, nullptr);
+    }
+    
+    return socket_burst_send(packets, nullptr);
 }
 
-bool FastComms::is_ready() const {
-    return initialized_ && socket_fd_ >= 0;
+int FastComms::burst_send(const std::vector<std::vector<uint8_t>>& packets,
+                          std::vector<uint8_t>& accepted) {
+    std::vector<ByteSpan> spans(packets.begin(), packets.end());
+    return burst_send(spans, accepted);
 }
 
-// Private helper methods
-
-int FastComms::create_raw_socket() {
-    int sockfd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+int FastComms::burst_send(const std::vector<ByteSpan>& packets,
+                          std::vector<uint8_t>& accepted) {
+    accepted.assign(packets.size(), 0);
     
-    if (sockfd < 0) {
-        std::cerr << "Failed to create raw socket (need root privileges)" << std::endl;
-        return -1;
+    if (tx_mode_ == TxMode::MMAP_RING) {
+        return ring_burst_send(packets, accepted.data());
+    }
+    if (tx_mode_ == TxMode::SENDMMSG) {
+        return batched_burst_send(packets, accepted.data());
+    }
+    if (tx_mode_ == TxMode::XDP) {
+        return xdp_burst_send(packets, accepted.data());
+    }
+    if (tx_mode_ == TxMode::IO_URING) {
+        return uring_burst_send(packets, accepted.data());
     }
     
-    return sockfd;
+    return socket_burst_send(packets, accepted.data());
 }
 
-int FastComms::bind_to_interface() {
-    struct ifreq ifr;
-    memset(&ifr, 0, sizeof(ifr));
-    strncpy(ifr.ifr_name, interface_name_.c_str(), IFNAMSIZ - 1);
+int FastComms::send_and_receive_batch(const std::vector<std::vector<uint8_t>>& requests,
+                                     std::vector<CommResult>& results) {
+    std::vector<ByteSpan> spans(requests.begin(), requests.end());
+    return send_and_receive_batch(spans, results);
+}
+
+int FastComms::send_and_receive_batch(const std::vector<ByteSpan>& requests,
+                                     std::vector<CommResult>& results) {
+    results.assign(requests.size(), CommResult());
     
-    // Get interface index
-    if (ioctl(socket_fd_, SIOCGIFINDEX, &ifr) < 0) {
-        std::cerr << "Failed to get interface index for " << interface_name_ << std::endl;
-        return -1;
-    }
+    // The io_uring path needs plain socket send/recv in both directions
+    bool socket_io = (rx_mode_ == RxMode::SOCKET) &&
+                     (tx_mode_ == TxMode::SOCKET || tx_mode_ == TxMode::SENDMMSG ||
+                      tx_mode_ == TxMode::IO_URING);
     
-    // Bind socket to interface
-    struct sockaddr_ll sll;
-    memset(&sll, 0, sizeof(sll));
-    sll.sll_family = AF_PACKET;
-    sll.sll_ifindex = ifr.ifr_ifindex;
-    sll.sll_protocol = htons(ETH_P_ALL);
+    // The ring has one owner for the whole batch
+    std::unique_lock<std::mutex> lock(tx_mutex_, std::defer_lock);
+    if (initialized_ && socket_io) {
+        lock.lock();
+        if (!uring_ready()) {
+            lock.unlock();
+        }
+    }
     
-    if (bind(socket_fd_, (struct sockaddr*)&sll, sizeof(sll)) < 0) {
-        std::cerr << "Failed to bind to interface " << interface_name_ << std::endl;
-        return -1;
+    if (!lock.owns_lock()) {
+        int success_count = 0;
+        for (size_t i = 0; i < requests.size(); i++) {
+            std::vector<uint8_t> response;
+            results[i] = send_and_receive(requests[i], response);
+            if (results[i].success) {
+                success_count++;
+            }
+        }
+        return success_count;
     }
     
-    return 0;
-}
-
-void FastComms::update_stats(bool sent, size_t bytes, uint64_t latency_us) {
-    if (sent) {
-        stats_.packets_sent++;
-        stats_.bytes_sent += bytes;
-    } else {
-        stats_.packets_received++;
-        stats_.bytes_received += bytes;
+    // Responses are matched to requests by AA55 sequence number, as in
+    // send_and_receive_pipelined, because receive completions on a raw
+    // socket say nothing about which request they answer. Requests without
+    // one go one at a time so the only response can be theirs
+    PipelineConfig matching;
+    std::vector<uint32_t> key_of(requests.size(), 0);
+    bool keyed = true;
+    for (size_t i = 0; i < requests.size() && keyed; i++) {
+        keyed = aa55_sequence(requests[i], matching.header_offset, key_of[i]);
+    }
+    if (!keyed) {
+        std::fill(key_of.begin(), key_of.end(), 0);
     }
     
-    // Update average latency (simple moving average)
-    if (latency_us > 0) {
-        stats_.avg_latency_us = (stats_.avg_latency_us * 0.9) + (latency_us * 0.1);
+    // One receive is kept posted per request waiting for its response;
+    // each one reports the packet type so our own looped-back frames are skipped
+    struct RecvSlot {
+        struct sockaddr_ll from;
+        struct iovec iov;
+        struct msghdr msg;
+        bool cancelled;
+    };
+    
+    size_t window = keyed ? std::min<size_t>(kUringDepth / 4, requests.size()) : 1;
+    std::vector<uint8_t> buffers(window * kUringRecvSize);
+    std::vector<RecvSlot> slots(window);
+    std::vector<uint32_t> free_slots;
+    std::vector<uint64_t> start_us(requests.size(), 0);
+    std::unordered_map<uint32_t, size_t> in_flight;     // key -> request index
+    std::vector<uint8_t> sending(requests.size(), 0);   // send not completed yet
+    std::vector<IoCompletion> completions;
+    uint64_t timeout_us = static_cast<uint64_t>(timeout_ms_) * 1000;
+    
+    // Completions of an earlier call carry another tag and are skipped;
+    // bit 0 tells receives from sends
+    uint64_t tag = static_cast<uint64_t>(++uring_call_) << kUringTagShift;
+    auto send_id = [tag](size_t index) { return tag | (static_cast<uint64_t>(index) << 1); };
+    auto recv_id = [tag](uint32_t slot) { return tag | (static_cast<uint64_t>(slot) << 1) | 1; };
+    
+    for (size_t i = window; i > 0; i--) {
+        free_slots.push_back(static_cast<uint32_t>(i - 1));
     }
-}
-
-uint64_t FastComms::get_timestamp_us() {
-    auto now = std::chrono::high_resolution_clock::now();
-    auto duration = now.time_since_epoch();
-    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
-}
-
-// PacketValidator Implementation
-
-uint32_t PacketValidator::calculate_crc32(const std::vector<uint8_t>& data) {
-    uint32_t crc = 0xFFFFFFFF;
     
-    for (uint8_t byte : data) {
-        crc ^= byte;
-        for (int i = 0; i < 8; i++) {
-            if (crc & 1) {
-                crc = (crc >> 1) ^ 0xEDB88320;
+    size_t next = 0;
+    size_t finished = 0;
+    size_t posted = 0;
+    size_t sends = 0;
+    int success_count = 0;
+    
+    auto fail = [&](size_t index, const char* message) {
+        in_flight.erase(key_of[index]);
+        results[index].error_message = message;
+        finished++;
+    };
+    
+    // Sends and receives still in the kernel use the caller's requests and
+    // our buffers, so every one of them is reaped before returning
+    while (finished < requests.size() || posted > 0 || sends > 0) {
+        uint64_t now = get_timestamp_us();
+        
+        if (finished < requests.size()) {
+            // A key already in flight waits for its response
+            while (next < requests.size() && in_flight.size() < window &&
+                   in_flight.count(key_of[next]) == 0 && uring_.space() >= 3) {
+                in_flight[key_of[next]] = next;
+                start_us[next] = now;
+                uring_.queue_send(socket_fd_, requests[next].data(), requests[next].size(),
+                                  send_id(next));
+                sending[next] = 1;
+                sends++;
+                next++;
+            }
+            
+            // Bound each receive by the oldest request's deadline
+            uint64_t earliest = UINT64_MAX;
+            for (const auto& entry : in_flight) {
+                earliest = std::min(earliest, start_us[entry.second] + timeout_us);
+            }
+            uint32_t wait_ms = earliest > now ? static_cast<uint32_t>((earliest - now + 999) / 1000) : 1;
+            
+            while (posted < in_flight.size() && !free_slots.empty() && uring_.space() >= 2) {
+                uint32_t slot = free_slots.back();
+                free_slots.pop_back();
+                
+                RecvSlot& recv = slots[slot];
+                memset(&recv.from, 0, sizeof(recv.from));
+                recv.iov.iov_base = buffers.data() + slot * kUringRecvSize;
+                recv.iov.iov_len = kUringRecvSize;
+                memset(&recv.msg, 0, sizeof(recv.msg));
+                recv.msg.msg_name = &recv.from;
+                recv.msg.msg_namelen = sizeof(recv.from);
+                recv.msg.msg_iov = &recv.iov;
+                recv.msg.msg_iovlen = 1;
+                recv.cancelled = false;
+                
+                uring_.queue_recvmsg(socket_fd_, &recv.msg, recv_id(slot),
+                                     std::max<uint32_t>(wait_ms, 1));
+                posted++;
+            }
+        } else {
+            // Everything is settled; cancel the receives still posted and
+            // sends stuck behind a full socket buffer
+            for (uint32_t slot = 0; slot < window && uring_.space() > 0; slot++) {
+                bool is_free = std::find(free_slots.begin(), free_slots.end(), slot) != free_slots.end();
+                if (!is_free && !slots[slot].cancelled) {
+                    uring_.queue_cancel(recv_id(slot));
+                    slots[slot].cancelled = true;
+                }
+            }
+            for (size_t index = 0; index < next && sends > 0 && uring_.space() > 0; index++) {
+                if (sending[index] == 1) {
+                    uring_.queue_cancel(send_id(index));
+                    sending[index] = 2;
+                }
+            }
+        }
+        
+        if (uring_.submit(1) < 0) {
+            // Tearing the ring down cancels the operations still using buffers
+            reset_uring();
+            count_errors(1);
+            for (CommResult& result : results) {
+                if (!result.success && result.error_message.empty()) {
+                    result.error_message = "io_uring submission failed";
+                }
+            }
+            break;
+        }
+        
+        completions.clear();
+        uring_.reap(completions, kUringDepth);
+        
+        for (const IoCompletion& completion : completions) {
+            if ((completion.user_data & ~kUringIndexMask) != tag) {
+                continue;
+            }
+            uint64_t id = (completion.user_data & kUringIndexMask) >> 1;
+            
+            if ((completion.user_data & 1) == 0) {
+                if (id >= next || sending[id] == 0) {
+                    continue;
+                }
+                size_t index = static_cast<size_t>(id);
+                sending[index] = 0;
+                sends--;
+                if (completion.result < 0) {
+                    count_errors(1);
+                    auto it = in_flight.find(key_of[index]);
+                    if (it != in_flight.end() && it->second == index) {
+                        fail(index, "Failed to send request");
+                    }
+                } else {
+                    count_sent(1, completion.result);
+                    capture_tx(requests[index]);
+                }
+                continue;
+            }
+            
+            if (id >= window) {
+                continue;
+            }
+            uint32_t slot = static_cast<uint32_t>(id);
+            free_slots.push_back(slot);
+            posted--;
+            
+            if (completion.result == -ECANCELED || completion.result == 0) {
+                continue;   // timed out or cancelled; deadlines are checked below
+            }
+            if (completion.result < 0) {
+                count_errors(1);
+                while (!in_flight.empty()) {
+                    fail(in_flight.begin()->second, "Failed to receive response");
+                }
+                continue;
+            }
+            
+            const RecvSlot& recv = slots[slot];
+            const uint8_t* data = buffers.data() + slot * kUringRecvSize;
+            size_t length = std::min<size_t>(completion.result, kUringRecvSize);
+            if (recv.from.sll_pkttype == PACKET_OUTGOING) {
+                continue;   // our own request looped back
+            }
+            
+            // Unsolicited and late frames are dropped; the receive is reposted
+            auto it = in_flight.end();
+            if (keyed) {
+                uint32_t key = 0;
+                if (aa55_sequence(ByteSpan(data, length), matching.header_offset, key)) {
+                    it = in_flight.find(key);
+                }
+            } else {
+                it = in_flight.begin();
+            }
+            if (it == in_flight.end()) {
+                continue;
+            }
+            
+            size_t index = it->second;
+            CommResult& result = results[index];
+            result.success = true;
+            result.data.assign(data, data + length);
+            result.latency_us = get_timestamp_us() - start_us[index];
+            result.latency_ns = result.latency_us * 1000;
+            if (capture_) {
+                PacketView view;
+                view.data = data;
+                view.length = static_cast<uint32_t>(length);
+                capture_rx(view);
+            }
+            update_stats(false, length, result.latency_us);
+            record_round_trip(result.latency_ns);
+            
+            in_flight.erase(it);
+            finished++;
+            success_count++;
+        }
+        
+        // Expire requests individually; the rest of the window keeps going
+        now = get_timestamp_us();
+        for (auto it = in_flight.begin(); it != in_flight.end();) {
+            if (start_us[it->second] + timeout_us <= now) {
+                results[it->second].error_message = "Response timeout";
+                it = in_flight.erase(it);
+                finished++;
             } else {
-                crc >>= 1;
+                ++it;
             }
         }
     }
     
-    return ~crc;
-}
-
-bool PacketValidator::verify_packet(const std::vector<uint8_t>& packet, 
-                                    uint32_t expected_crc) {
-    return calculate_crc32(packet) == expected_crc;
+    return success_count;
 }
 
-uint16_t PacketValidator::calculate_simple_checksum(const std::vector<uint8_t>& data) {
-    uint32_t sum = 0;
+int FastComms::send_and_receive_pipelined(const std::vector<ByteSpan>& requests,
+                                         std::vector<CommResult>& results,
+                                         const PipelineConfig& config) {
+    results.assign(requests.size(), CommResult());
     
-    for (size_t i = 0; i < data.size(); i += 2) {
-        uint16_t word = data[i] << 8;
-        if (i + 1 < data.size()) {
-            word |= data[i + 1];
+    if (!initialized_ || socket_fd_ < 0) {
+        for (CommResult& result : results) {
+            result.error_message = "Channel not initialized";
         }
-        sum += word;
+        return 0;
     }
     
-    while (sum >> 16) {
-        sum = (sum & 0xFFFF) + (sum >> 16);
+    size_t window = config.window > 0 ? config.window : 1;
+    uint64_t timeout_us = static_cast<uint64_t>(config.timeout_ms) * 1000;
+    
+    auto key_of = [&config](ByteSpan frame, uint32_t& key) {
+        if (config.matcher) {
+            return config.matcher(frame, key);
+        }
+        return aa55_sequence(frame, config.header_offset, key);
+    };
+    
+    struct InFlight {
+        size_t index;
+        uint64_t sent_us;
+    };
+    std::unordered_map<uint32_t, InFlight> in_flight;
+    in_flight.reserve(window * 2);
+    
+    // Responses for this window must not be consumed by other receivers
+    std::lock_guard<std::mutex> lock(rx_mutex_);
+    if (in_place_rx() && !check_view_owner()) {
+        for (CommResult& result : results) {
+            result.error_message = "Failed to receive response";
+        }
+        return 0;
     }
     
-    return ~sum & 0xFFFF;
+    size_t next = 0;
+    size_t finished = 0;
+    int success_count = 0;
+    PacketView view;
+    
+    while (finished < requests.size()) {
+        // Top up the window; a key already in flight waits for its response
+        // so the two answers cannot be confused
+        while (next < requests.size() && in_flight.size() < window) {
+            uint32_t key = 0;
+            if (!key_of(requests[next], key)) {
+                results[next].error_message = "Request has no sequence number";
+                next++;
+                finished++;
+                continue;
+            }
+            if (in_flight.count(key) != 0) {
+                break;
+            }
+            
+            uint64_t now = get_timestamp_us();
+            if (!send_packet(requests[next])) {
+                results[next].error_message = "Failed to send request";
+                next++;
+                finished++;
+                continue;
+            }
+            
+            InFlight entry;
+            entry.index = next;
+            entry.sent_us = now;
+            in_flight[key] = entry;
+            next++;
+        }
+        
+        if (in_flight.empty()) {
+            continue;
+        }
+        
+        // Match everything that has already arrived
+        size_t completed = 0;
+        int ready;
+        while ((ready = poll_response(view)) > 0) {
+            uint32_t key = 0;
+            if (!key_of(ByteSpan(view.data, view.length), key)) {
+                continue;
+            }
+            
+            auto it = in_flight.find(key);
+            if (it == in_flight.end()) {
+                continue;   // late or unsolicited
+            }
+            
+            CommResult& result = results[it->second.index];
+            result.success = true;
+            result.data.assign(view.data, view.data + view.length);
+            result.latency_us = get_timestamp_us() - it->second.sent_us;
+            result.latency_ns = result.latency_us * 1000;
+            record_round_trip(result.latency_ns);
+            
+            in_flight.erase(it);
+            success_count++;
+            completed++;
+        }
+        if (ready < 0) {
+            for (auto& entry : in_flight) {
+                results[entry.second.index].error_message = "Failed to receive response";
+            }
+            finished += completed + in_flight.size();
+            in_flight.clear();
+            continue;
+        }
+        
+        // Expire requests individually; the rest of the window keeps going
+        uint64_t now = get_timestamp_us();
+        uint64_t earliest = UINT64_MAX;
+        for (auto it = in_flight.begin(); it != in_flight.end();) {
+            uint64_t deadline = it->second.sent_us + timeout_us;
+            if (deadline <= now) {
+                results[it->second.index].error_message = "Response timeout";
+                it = in_flight.erase(it);
+                completed++;
+            } else {
+                earliest = std::min(earliest, deadline);
+                ++it;
+            }
+        }
+        finished += completed;
+        
+        // Nothing moved: sleep until a frame arrives or the oldest request expires
+        if (completed == 0 && !in_flight.empty()) {
+            wait_readable(static_cast<uint32_t>((earliest - now + 999) / 1000));
+        }
+    }
+    
+    return success_count;
+}
+
+int FastComms::send_and_receive_pipelined(const std::vector<std::vector<uint8_t>>& requests,
+                                         std::vector<CommResult>& results,
+                                         const PipelineConfig& config) {
+    std::vector<ByteSpan> spans(requests.begin(), requests.end());
+    return send_and_receive_pipelined(spans, results, config);
+}
+
+bool FastComms::aa55_sequence(ByteSpan frame, size_t header_offset, uint32_t& sequence) {
+    // [0xAA55][CMD][SEQ hi][SEQ lo]...
+    if (frame.size() < header_offset + 5) {
+        return false;
+    }
+    
+    const uint8_t* header = frame.data() + header_offset;
+    if (header[0] != 0xAA || header[1] != 0x55) {
+        return false;
+    }
+    
+    sequence = (static_cast<uint32_t>(header[3]) << 8) | header[4];
+    return true;
+}
+
+int64_t FastComms::measure_latency(ByteSpan payload) {
+    std::vector<uint8_t> response;
+    CommResult result = send_and_receive(payload, response);
+    
+    if (result.success) {
+        return result.latency_us;
+    }
+    
+    return -1;
+}
+
+int64_t FastComms::measure_latency_ns(ByteSpan payload) {
+    std::vector<uint8_t> response;
+    CommResult result = send_and_receive(payload, response);
+    
+    if (result.success) {
+        return static_cast<int64_t>(result.latency_ns);
+    }
+    
+    return -1;
+}
+
+PacketStats FastComms::stress_test(uint32_t duration_ms, size_t packet_size) {
+    // Create test packet
+    std::vector<uint8_t> test_packet(packet_size, 0xAA);
+    
+    stress_stop_.store(false);
+    uint64_t start_time = get_timestamp_us();
+    uint64_t end_time = start_time + (static_cast<uint64_t>(duration_ms) * 1000);
+    
+    PacketStats test_stats = run_stress(test_packet, end_time, stress_stop_);
+    
+    uint64_t total_time_us = get_timestamp_us() - start_time;
+    
+    // Calculate throughput
+    if (total_time_us > 0) {
+        double time_sec = total_time_us / 1000000.0;
+        double pps = test_stats.packets_sent / time_sec;
+        double mbps = (test_stats.bytes_sent * 8.0) / (time_sec * 1000000.0);
+        std::cout << "Stress test (" << tx_mode_name(tx_mode_) << "): "
+                  << test_stats.packets_sent << " packets, " << pps << " pps, " << mbps << " Mbps" << std::endl;
+    }
+    
+    return test_stats;
+}
+
+StressResult FastComms::stress_test_parallel(uint32_t duration_ms, const StressConfig& config) {
+    StressResult result;
+    
+    std::vector<uint8_t> frame = config.frame;
+    if (frame.empty()) {
+        frame.assign(config.packet_size, 0xAA);
+    }
+    
+    // One transmit-only socket per worker, opened up front so every
+    // worker starts sending at the same time
+    uint32_t threads = std::max<uint32_t>(config.threads, 1);
+    std::vector<std::unique_ptr<FastComms>> workers;
+    
+    for (uint32_t i = 0; i < threads; i++) {
+        std::unique_ptr<FastComms> worker(new FastComms(interface_name_, timeout_ms_));
+        worker->set_transmit_only(true);
+        worker->set_qdisc_bypass(config.qdisc_bypass);
+        worker->set_tx_batch_size(tx_batch_size_);
+        worker->ring_config_ = ring_config_;
+        
+        // AF_XDP sockets cannot share a queue; give each worker the next one
+        XdpConfig xdp = xdp_config_;
+        xdp.queue_id += i;
+        worker->set_xdp_config(xdp);
+        
+        if (!worker->initialize(tx_mode_, RxMode::SOCKET)) {
+            std::cerr << "Stress worker " << i << " failed to start" << std::endl;
+            continue;
+        }
+        workers.push_back(std::move(worker));
+    }
+    
+    result.per_thread.resize(workers.size());
+    std::vector<std::thread> pool;
+    
+    stress_stop_.store(false);
+    uint64_t start_time = get_timestamp_us();
+    uint64_t end_time = start_time + (static_cast<uint64_t>(duration_ms) * 1000);
+    
+    for (size_t i = 0; i < workers.size(); i++) {
+        int cpu = (i < config.cpus.size()) ? config.cpus[i] : static_cast<int>(i);
+        pool.emplace_back([&, i, cpu]() {
+            pin_thread_to_cpu(cpu);
+            // Each worker gets its own copy of the frame (no shared cache lines)
+            std::vector<uint8_t> local(frame);
+            result.per_thread[i] = workers[i]->run_stress(local, end_time, stress_stop_);
+        });
+    }
+    
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    
+    result.elapsed_s = (get_timestamp_us() - start_time) / 1000000.0;
+    
+    for (const PacketStats& stats : result.per_thread) {
+        result.total.packets_sent += stats.packets_sent;
+        result.total.bytes_sent += stats.bytes_sent;
+        result.total.errors += stats.errors;
+    }
+    count_sent(result.total.packets_sent, result.total.bytes_sent);
+    count_errors(result.total.errors);
+    
+    if (result.elapsed_s > 0) {
+        result.pps = result.total.packets_sent / result.elapsed_s;
+        result.mbps = (result.total.bytes_sent * 8.0) / (result.elapsed_s * 1000000.0);
+        std::cout << "Stress test (" << tx_mode_name(tx_mode_) << ", " << workers.size()
+                  << " threads): " << result.total.packets_sent << " packets, "
+                  << result.pps << " pps, " << result.mbps << " Mbps" << std::endl;
+    }
+    
+    return result;
+}
+
+void FastComms::stop_stress_test() {
+    stress_stop_.store(true);
+}
+
+PacketStats FastComms::get_statistics() const {
+    collect_kernel_drops();
+    
+    PacketStats stats;
+    uint64_t latency_sum_us = 0;
+    uint64_t latency_samples = 0;
+    
+    for (const StatsShard& shard : stats_shards_) {
+        stats.packets_sent += shard.packets_sent.load(std::memory_order_relaxed);
+        stats.packets_received += shard.packets_received.load(std::memory_order_relaxed);
+        stats.bytes_sent += shard.bytes_sent.load(std::memory_order_relaxed);
+        stats.bytes_received += shard.bytes_received.load(std::memory_order_relaxed);
+        stats.errors += shard.errors.load(std::memory_order_relaxed);
+        latency_sum_us += shard.latency_sum_us.load(std::memory_order_relaxed);
+        latency_samples += shard.latency_samples.load(std::memory_order_relaxed);
+    }
+    round_trips_.snapshot_into(stats.latency);
+    
+    if (latency_samples > 0) {
+        stats.avg_latency_us = static_cast<double>(latency_sum_us) / latency_samples;
+    }
+    stats.kernel_drops = kernel_drops_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void FastComms::reset_statistics() {
+    // Reading the kernel counters also clears them
+    collect_kernel_drops();
+    
+    for (StatsShard& shard : stats_shards_) {
+        shard.reset();
+    }
+    round_trips_.reset();
+    kernel_drops_.store(0, std::memory_order_relaxed);
+}
+
+void FastComms::set_timeout(uint32_t timeout_ms) {
+    timeout_ms_ = timeout_ms;
+    
+    if (initialized_ && socket_fd_ >= 0) {
+        struct timeval tv;
+        tv.tv_sec = timeout_ms_ / 1000;
+        tv.tv_usec = (timeout_ms_ % 1000) * 1000;
+        setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+}
+
+bool FastComms::is_ready() const {
+    return initialized_ && socket_fd_ >= 0;
+}
+
+int FastComms::get_fd() const {
+    if (rx_mode_ == RxMode::XDP && xsk_.is_open()) {
+        return xsk_.fd();
+    }
+    return socket_fd_;
+}
+
+TxMode FastComms::get_tx_mode() const {
+    return tx_mode_;
+}
+
+RxMode FastComms::get_rx_mode() const {
+    return rx_mode_;
+}
+
+bool FastComms::set_receive_buffer_size(uint32_t bytes) {
+    if (!initialized_ || socket_fd_ < 0) {
+        return false;
+    }
+    
+    int size = static_cast<int>(bytes);
+    
+    // SO_RCVBUFFORCE ignores rmem_max but needs CAP_NET_ADMIN
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) == 0) {
+        return true;
+    }
+    return setsockopt(socket_fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) == 0;
+}
+
+void FastComms::set_tx_batch_size(uint32_t batch_size) {
+    tx_batch_size_ = std::max<uint32_t>(1, std::min<uint32_t>(batch_size, UIO_MAXIOV));
+}
+
+void FastComms::set_xdp_config(const XdpConfig& config) {
+    xdp_config_ = config;
+}
+
+bool FastComms::is_xdp_zero_copy() const {
+    return xsk_.is_open() && xsk_.is_zero_copy();
+}
+
+void FastComms::set_rx_block_timeout(uint32_t timeout_ms) {
+    ring_config_.rx_retire_timeout_ms = timeout_ms;
+}
+
+void FastComms::set_latency_histogram(const HistogramConfig& config) {
+    round_trips_.configure(config);
+}
+
+void FastComms::set_qdisc_bypass(bool enable) {
+    qdisc_bypass_ = enable;
+}
+
+void FastComms::set_transmit_only(bool enable) {
+    transmit_only_ = enable;
+}
+
+bool FastComms::set_filter(const std::string& expression) {
+    PacketFilter filter;
+    if (!filter.compile(expression)) {
+        std::cerr << "Invalid filter expression: " << filter.error() << std::endl;
+        return false;
+    }
+    
+    // The kernel swaps programs atomically; frames already queued were
+    // accepted by the previous filter and are still delivered
+    if (socket_fd_ >= 0 && !filter.attach(socket_fd_)) {
+        return false;
+    }
+    
+    filter_ = filter;
+    return true;
+}
+
+void FastComms::clear_filter() {
+    set_filter("");
+}
+
+std::string FastComms::get_filter() const {
+    return filter_.expression();
+}
+
+bool FastComms::enable_timestamping(bool hardware) {
+    timestamping_ = true;
+    hardware_requested_ = hardware;
+    
+    if (socket_fd_ < 0) {
+        return true;
+    }
+    return apply_timestamping();
+}
+
+bool FastComms::start_capture(const CaptureConfig& config) {
+    stop_capture();
+    
+    std::unique_ptr<PcapngWriter> writer(new PcapngWriter());
+    if (!writer->open(config, interface_name_)) {
+        return false;
+    }
+    
+    capture_transmit_ = config.transmit;
+    capture_ = std::move(writer);
+    return true;
+}
+
+void FastComms::stop_capture() {
+    if (capture_) {
+        capture_->close();
+    }
+}
+
+bool FastComms::is_capturing() const {
+    return capture_ && capture_->is_open();
+}
+
+CaptureStats FastComms::get_capture_statistics() const {
+    return capture_ ? capture_->get_statistics() : CaptureStats();
+}
+
+bool FastComms::has_hardware_timestamps() const {
+    return hardware_timestamps_;
+}
+
+// Private helper methods
+
+PacketStats FastComms::run_stress(ByteSpan frame, uint64_t end_time, const std::atomic<bool>& stop) {
+    PacketStats test_stats;
+    size_t frame_size = frame.size();
+    
+    auto running = [&]() {
+        return !stop.load(std::memory_order_relaxed) && get_timestamp_us() < end_time;
+    };
+    
+    // Ring, UMEM or batch headers belong to this run until it ends
+    std::unique_lock<std::mutex> lock;
+    if (tx_mode_ == TxMode::XDP) {
+        lock = std::unique_lock<std::mutex>(xdp_mutex_);
+    } else if (tx_mode_ != TxMode::SOCKET) {
+        lock = std::unique_lock<std::mutex>(tx_mutex_);
+    }
+    
+    if (tx_mode_ == TxMode::MMAP_RING) {
+        // Fill the ring in batches and kick once per batch
+        while (running()) {
+            for (uint32_t i = 0; i < kRingKickBatch; i++) {
+                if (ring_.tx_enqueue(frame.data(), frame_size)) {
+                    test_stats.packets_sent++;
+                    test_stats.bytes_sent += frame_size;
+                } else {
+                    test_stats.errors++;
+                }
+            }
+            if (ring_.tx_flush(false) < 0) {
+                test_stats.errors++;
+            }
+        }
+        ring_.tx_flush(true);
+        
+        count_sent(test_stats.packets_sent, test_stats.bytes_sent);
+        count_errors(test_stats.errors);
+    } else if (tx_mode_ == TxMode::XDP) {
+        // Same batching as the ring: fill UMEM, wake the kernel once per batch
+        while (running()) {
+            for (uint32_t i = 0; i < kRingKickBatch; i++) {
+                if (xsk_.send(frame.data(), frame_size)) {
+                    test_stats.packets_sent++;
+                    test_stats.bytes_sent += frame_size;
+                } else {
+                    test_stats.errors++;
+                }
+            }
+            if (xsk_.kick() < 0) {
+                test_stats.errors++;
+            }
+        }
+        
+        count_sent(test_stats.packets_sent, test_stats.bytes_sent);
+        count_errors(test_stats.errors);
+    } else if (tx_mode_ == TxMode::IO_URING && uring_ready()) {
+        // Keep the submission queue full and reap completions in bulk
+        std::vector<IoCompletion> completions;
+        
+        while (running()) {
+            while (uring_.queue_send(socket_fd_, frame.data(), frame_size, 0)) {
+            }
+            if (uring_.submit(1) < 0) {
+                reset_uring();
+                test_stats.errors++;
+                break;
+            }
+            completions.clear();
+            uring_.reap(completions, kUringDepth);
+            for (const IoCompletion& completion : completions) {
+                if (completion.result >= 0) {
+                    test_stats.packets_sent++;
+                    test_stats.bytes_sent += frame_size;
+                } else {
+                    test_stats.errors++;
+                }
+            }
+        }
+        
+        // Drain what is still in flight so the frame outlives its sends
+        while (uring_.in_flight() > 0 && uring_.submit(1) >= 0) {
+            completions.clear();
+            uring_.reap(completions, kUringDepth);
+            for (const IoCompletion& completion : completions) {
+                if (completion.result >= 0) {
+                    test_stats.packets_sent++;
+                    test_stats.bytes_sent += frame_size;
+                }
+            }
+        }
+        
+        count_sent(test_stats.packets_sent, test_stats.bytes_sent);
+        count_errors(test_stats.errors);
+    } else if (tx_mode_ == TxMode::SENDMMSG) {
+        // Every slot of the batch points at the same frame
+        size_t batch = prepare_tx_batch(tx_batch_size_);
+        for (size_t i = 0; i < batch; i++) {
+            tx_iovs_[i].iov_base = const_cast<uint8_t*>(frame.data());
+            tx_iovs_[i].iov_len = frame_size;
+        }
+        
+        while (running()) {
+            int sent = sendmmsg(socket_fd_, tx_msgs_.data(), batch, 0);
+            if (sent < 0) {
+                test_stats.errors++;
+                continue;
+            }
+            test_stats.packets_sent += sent;
+            test_stats.bytes_sent += static_cast<uint64_t>(sent) * frame_size;
+        }
+        
+        count_sent(test_stats.packets_sent, test_stats.bytes_sent);
+        count_errors(test_stats.errors);
+    } else {
+        // Plain send(), like the other branches: stress frames are neither
+        // captured nor timed one by one
+        while (running()) {
+            if (send(socket_fd_, frame.data(), frame_size, 0) == static_cast<ssize_t>(frame_size)) {
+                test_stats.packets_sent++;
+                test_stats.bytes_sent += frame_size;
+            } else {
+                test_stats.errors++;
+            }
+        }
+        
+        count_sent(test_stats.packets_sent, test_stats.bytes_sent);
+        count_errors(test_stats.errors);
+    }
+    
+    return test_stats;
+}
+
+int FastComms::create_raw_socket() {
+    // Protocol 0 receives nothing until bind_to_interface() sets one, and
+    // a send-only socket never does, so it costs no copies
+    int sockfd = socket(AF_PACKET, SOCK_RAW, 0);
+    
+    if (sockfd < 0) {
+        std::cerr << "Failed to create raw socket (need root privileges)" << std::endl;
+        return -1;
+    }
+    
+    return sockfd;
+}
+
+int FastComms::bind_to_interface() {
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, interface_name_.c_str(), IFNAMSIZ - 1);
+    
+    // Get interface index
+    if (ioctl(socket_fd_, SIOCGIFINDEX, &ifr) < 0) {
+        std::cerr << "Failed to get interface index for " << interface_name_ << std::endl;
+        return -1;
+    }
+    
+    // Bind socket to interface
+    struct sockaddr_ll sll;
+    memset(&sll, 0, sizeof(sll));
+    sll.sll_family = AF_PACKET;
+    sll.sll_ifindex = ifr.ifr_ifindex;
+    sll.sll_protocol = transmit_only_ ? 0 : htons(ETH_P_ALL);
+    
+    if (bind(socket_fd_, (struct sockaddr*)&sll, sizeof(sll)) < 0) {
+        std::cerr << "Failed to bind to interface " << interface_name_ << std::endl;
+        return -1;
+    }
+    
+    if (qdisc_bypass_) {
+        int one = 1;
+        if (setsockopt(socket_fd_, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one)) < 0) {
+            std::cerr << "Warning: Failed to bypass qdisc" << std::endl;
+        }
+    }
+    
+    return 0;
+}
+
+bool FastComms::setup_rings(bool tx, bool rx) {
+    ring_config_.tx_enabled = tx;
+    ring_config_.rx_enabled = rx;
+    return ring_.setup(socket_fd_, ring_config_);
+}
+
+bool FastComms::in_place_rx() const {
+    return rx_mode_ == RxMode::MMAP_RING || rx_mode_ == RxMode::XDP;
+}
+
+bool FastComms::poll_view(PacketView& view) {
+    if (rx_mode_ == RxMode::XDP) {
+        std::lock_guard<std::mutex> lock(xdp_mutex_);
+        return xsk_.receive(view);
+    }
+    return ring_.rx_next(view);
+}
+
+int FastComms::next_view(PacketView& view, uint32_t timeout_ms) {
+    if (poll_view(view)) {
+        return 1;
+    }
+    
+    uint64_t deadline = get_timestamp_us() + static_cast<uint64_t>(timeout_ms) * 1000;
+    int fd = (rx_mode_ == RxMode::XDP) ? xsk_.fd() : socket_fd_;
+    
+    // Sleep until the kernel hands over frames or the timeout expires
+    while (!poll_view(view)) {
+        uint64_t now = get_timestamp_us();
+        if (now >= deadline) {
+            return 0;
+        }
+        
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN | POLLERR;
+        pfd.revents = 0;
+        
+        int wait_ms = static_cast<int>((deadline - now + 999) / 1000);
+        if (poll(&pfd, 1, wait_ms) < 0 && errno != EINTR) {
+            count_errors(1);
+            return -1;
+        }
+    }
+    
+    return 1;
+}
+
+int FastComms::wait_readable(uint32_t timeout_ms) {
+    struct pollfd pfd;
+    pfd.fd = get_fd();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    
+    int ready = poll(&pfd, 1, static_cast<int>(timeout_ms));
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        count_errors(1);
+        return -1;
+    }
+    
+    return ready;
+}
+
+int FastComms::receive_into(uint8_t* buffer, size_t capacity, PacketView& frame,
+                            bool skip_outgoing) {
+    if (!initialized_ || socket_fd_ < 0) {
+        return -1;
+    }
+    
+    uint64_t deadline = get_timestamp_us() + static_cast<uint64_t>(timeout_ms_) * 1000;
+    
+    if (in_place_rx()) {
+        // Copy while holding the lock so the frame cannot be recycled under us
+        std::lock_guard<std::mutex> lock(rx_mutex_);
+        if (!check_view_owner()) {
+            return -1;
+        }
+        PacketView view;
+        for (;;) {
+            uint64_t now = get_timestamp_us();
+            uint32_t wait_ms = now < deadline ? static_cast<uint32_t>((deadline - now + 999) / 1000) : 0;
+            
+            int ready = next_view(view, wait_ms);
+            if (ready <= 0) {
+                return ready;
+            }
+            
+            capture_rx(view);
+            if (!skip_outgoing || !view.outgoing) {
+                update_stats(false, view.length, 0);
+                break;
+            }
+        }
+        
+        size_t copy_len = std::min<size_t>(view.length, capacity);
+        memcpy(buffer, view.data, copy_len);
+        frame = view;
+        frame.data = buffer;
+        frame.length = static_cast<uint32_t>(copy_len);
+        return static_cast<int>(copy_len);
+    }
+    
+    // Stack control buffer: this path takes no lock
+    alignas(struct cmsghdr) uint8_t control[kRxControlSize];
+    
+    for (;;) {
+        struct sockaddr_ll from;
+        memset(&from, 0, sizeof(from));
+        
+        struct iovec iov;
+        iov.iov_base = buffer;
+        iov.iov_len = capacity;
+        
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &from;
+        msg.msg_namelen = sizeof(from);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        
+        // Each wait gets only what is left of the timeout, so skipped
+        // outgoing frames cannot stretch the call (0 blocks, as SO_RCVTIMEO does)
+        int flags = 0;
+        if (timeout_ms_ > 0) {
+            uint64_t now = get_timestamp_us();
+            if (now >= deadline) {
+                return 0;
+            }
+            int ready = wait_readable(static_cast<uint32_t>((deadline - now + 999) / 1000));
+            if (ready < 0) {
+                return -1;
+            }
+            if (ready == 0) {
+                continue;
+            }
+            flags = MSG_DONTWAIT;
+        }
+        
+        ssize_t received = recvmsg(socket_fd_, &msg, flags);
+        
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                if (flags != 0) {
+                    continue;   // another receiver took it
+                }
+                return 0;
+            }
+            count_errors(1);
+            return -1;
+        }
+        
+        uint64_t now_us = get_timestamp_us();
+        
+        frame.data = buffer;
+        frame.length = static_cast<uint32_t>(std::min<size_t>(received, capacity));
+        frame.outgoing = (from.sll_pkttype == PACKET_OUTGOING);
+        frame.timestamp_ns = rx_timestamp_ns(msg, now_us * 1000, &frame.hardware_timestamp);
+        capture_rx(frame);
+        
+        if (!skip_outgoing || !frame.outgoing) {
+            update_stats(false, received, 0);
+            return static_cast<int>(received);
+        }
+    }
+}
+
+int FastComms::exchange(ByteSpan request, uint8_t* buffer, size_t capacity, CommResult& result) {
+    uint64_t start_ns = get_timestamp_ns();
+    uint64_t tx_software_ns = 0;
+    uint64_t tx_hardware_ns = 0;
+    
+    // The TX timestamp is requested per sendmsg(). With a TX ring or AF_XDP
+    // attached, sendmsg() would go through the ring and ignore the request,
+    // so those modes send normally and time the exchange in user space
+    bool timestamped_send = timestamping_ && tx_mode_ != TxMode::MMAP_RING &&
+                            tx_mode_ != TxMode::XDP;
+    bool sent = timestamped_send ? send_timestamped(request, tx_software_ns, tx_hardware_ns)
+                                 : send_packet(request);
+    if (!sent) {
+        result.error_message = "Failed to send request";
+        return -1;
+    }
+    
+    // Our own request looped back by the socket is skipped
+    PacketView frame;
+    int received = receive_into(buffer, capacity, frame, true);
+    uint64_t end_ns = get_timestamp_ns();
+    
+    if (received < 0) {
+        result.error_message = "Failed to receive response";
+        return received;
+    }
+    
+    if (received == 0) {
+        result.error_message = "Response timeout";
+        return received;
+    }
+    
+    result.success = true;
+    result.rx_timestamp_ns = frame.timestamp_ns;
+    
+    // Only compare stamps taken by the same clock (NIC or system)
+    uint64_t tx_ns = frame.hardware_timestamp ? tx_hardware_ns : tx_software_ns;
+    if (tx_ns != 0 && frame.timestamp_ns > tx_ns) {
+        result.tx_timestamp_ns = tx_ns;
+        result.latency_ns = frame.timestamp_ns - tx_ns;
+    } else {
+        result.latency_ns = end_ns - start_ns;
+    }
+    result.latency_us = result.latency_ns / 1000;
+    record_round_trip(result.latency_ns);
+    
+    return received;
+}
+
+bool FastComms::apply_timestamping() {
+    hardware_timestamps_ = false;
+    
+    if (hardware_requested_) {
+        struct hwtstamp_config config;
+        memset(&config, 0, sizeof(config));
+        config.tx_type = HWTSTAMP_TX_ON;
+        config.rx_filter = HWTSTAMP_FILTER_ALL;
+        
+        struct ifreq ifr;
+        memset(&ifr, 0, sizeof(ifr));
+        strncpy(ifr.ifr_name, interface_name_.c_str(), IFNAMSIZ - 1);
+        ifr.ifr_data = reinterpret_cast<char*>(&config);
+        
+        if (ioctl(socket_fd_, SIOCSHWTSTAMP, &ifr) == 0 && config.rx_filter != HWTSTAMP_FILTER_NONE) {
+            hardware_timestamps_ = true;
+        } else {
+            std::cerr << "Warning: " << interface_name_
+                      << " has no hardware timestamping, using software timestamps" << std::endl;
+        }
+    }
+    
+    // RX stamps on every frame; TX stamps are requested per send. TSONLY
+    // keeps the looped-back payload off the error queue
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                SOF_TIMESTAMPING_OPT_TSONLY;
+    if (hardware_timestamps_) {
+        flags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+    }
+    
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0) {
+        std::cerr << "Failed to enable SO_TIMESTAMPING: " << strerror(errno) << std::endl;
+        hardware_timestamps_ = false;
+        return false;
+    }
+    
+    // The RX ring stamps frames itself; ask it for the NIC clock
+    if (hardware_timestamps_) {
+        int ring_flags = SOF_TIMESTAMPING_RAW_HARDWARE;
+        if (setsockopt(socket_fd_, SOL_PACKET, PACKET_TIMESTAMP, &ring_flags, sizeof(ring_flags)) < 0) {
+            std::cerr << "Warning: RX ring keeps software timestamps" << std::endl;
+        }
+    }
+    
+    return true;
+}
+
+bool FastComms::send_timestamped(ByteSpan data, uint64_t& software_ns, uint64_t& hardware_ns) {
+    software_ns = 0;
+    hardware_ns = 0;
+    
+    // Held until the TX timestamp is read so concurrent senders cannot
+    // take each other's error-queue entries
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    
+    alignas(struct cmsghdr) uint8_t control[kRxControlSize];
+    
+    // Drop stamps left behind by earlier requests; no iov, so the looped
+    // packet copy is truncated instead of landing anywhere
+    struct msghdr stale;
+    memset(&stale, 0, sizeof(stale));
+    stale.msg_control = control;
+    stale.msg_controllen = sizeof(control);
+    while (recvmsg(socket_fd_, &stale, MSG_ERRQUEUE | MSG_DONTWAIT) >= 0) {
+        stale.msg_controllen = sizeof(control);
+    }
+    
+    struct iovec iov;
+    iov.iov_base = const_cast<uint8_t*>(data.data());
+    iov.iov_len = data.size();
+    
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    
+    memset(control, 0, sizeof(control));
+    msg.msg_control = control;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int));
+    
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SO_TIMESTAMPING;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    int tx_flags = SOF_TIMESTAMPING_TX_SOFTWARE;
+    if (hardware_timestamps_) {
+        tx_flags |= SOF_TIMESTAMPING_TX_HARDWARE;
+    }
+    memcpy(CMSG_DATA(cmsg), &tx_flags, sizeof(tx_flags));
+    
+    uint64_t start_time = get_timestamp_us();
+    ssize_t sent = sendmsg(socket_fd_, &msg, 0);
+    if (sent < 0) {
+        count_errors(1);
+        return false;
+    }
+    update_stats(true, sent, get_timestamp_us() - start_time);
+    capture_tx(data);
+    
+    // Software stamps are taken in the driver's xmit path; NIC stamps
+    // arrive after completion, so wait briefly for both
+    int wanted = hardware_timestamps_ ? 2 : 1;
+    int found = 0;
+    uint64_t deadline = get_timestamp_us() + kTxTimestampWaitMs * 1000;
+    
+    while (found < wanted) {
+        struct pollfd pfd;
+        pfd.fd = socket_fd_;
+        pfd.events = 0;             // POLLERR is always reported
+        pfd.revents = 0;
+        
+        uint64_t now = get_timestamp_us();
+        if (now >= deadline) {
+            break;
+        }
+        if (poll(&pfd, 1, static_cast<int>((deadline - now + 999) / 1000)) <= 0) {
+            break;
+        }
+        
+        struct msghdr err;
+        memset(&err, 0, sizeof(err));
+        err.msg_control = control;
+        err.msg_controllen = sizeof(control);
+        if (recvmsg(socket_fd_, &err, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            continue;
+        }
+        
+        for (struct cmsghdr* c = CMSG_FIRSTHDR(&err); c != nullptr; c = CMSG_NXTHDR(&err, c)) {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMPING) {
+                struct scm_timestamping stamps;
+                memcpy(&stamps, CMSG_DATA(c), sizeof(stamps));
+                uint64_t sw = static_cast<uint64_t>(stamps.ts[0].tv_sec) * 1000000000ULL + stamps.ts[0].tv_nsec;
+                uint64_t hw = static_cast<uint64_t>(stamps.ts[2].tv_sec) * 1000000000ULL + stamps.ts[2].tv_nsec;
+                if (sw != 0 && software_ns == 0) {
+                    software_ns = sw;
+                    found++;
+                }
+                if (hw != 0 && hardware_ns == 0) {
+                    hardware_ns = hw;
+                    found++;
+                }
+            }
+        }
+    }
+    
+    return true;
+}
+
+int FastComms::read_socket_frame(PacketView& view, std::vector<uint8_t>& storage) {
+    enable_rx_timestamps();
+    
+    if (storage.size() < kScratchFrameSize) {
+        storage.resize(kScratchFrameSize);
+    }
+    if (rx_control_.size() < kRxControlSize) {
+        rx_control_.resize(kRxControlSize);
+    }
+    
+    struct sockaddr_ll from;
+    memset(&from, 0, sizeof(from));
+    
+    struct iovec iov;
+    iov.iov_base = storage.data();
+    iov.iov_len = storage.size();
+    
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &from;
+    msg.msg_namelen = sizeof(from);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = rx_control_.data();
+    msg.msg_controllen = kRxControlSize;
+    
+    ssize_t received = recvmsg(socket_fd_, &msg, MSG_DONTWAIT);
+    if (received < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return 0;
+        }
+        count_errors(1);
+        return -1;
+    }
+    
+    view.data = storage.data();
+    view.length = static_cast<uint32_t>(received);
+    view.timestamp_ns = rx_timestamp_ns(msg, get_timestamp_us() * 1000);
+    view.outgoing = (from.sll_pkttype == PACKET_OUTGOING);
+    
+    return static_cast<int>(received);
+}
+
+bool FastComms::check_view_owner() {
+    // Caller holds rx_mutex_
+    if (view_owner_ == std::thread::id() || view_owner_ == std::this_thread::get_id()) {
+        return true;
+    }
+    if (!view_owner_warned_) {
+        std::cerr << "Warning: receive_view is in use on " << interface_name_
+                  << "; only that thread may receive on this channel" << std::endl;
+        view_owner_warned_ = true;
+    }
+    return false;
+}
+
+int FastComms::poll_response(PacketView& view) {
+    for (;;) {
+        int received;
+        if (in_place_rx()) {
+            received = poll_view(view) ? static_cast<int>(view.length) : 0;
+        } else {
+            received = read_socket_frame(view, rx_scratch_);
+        }
+        if (received <= 0) {
+            return received;
+        }
+        
+        capture_rx(view);
+        if (!view.outgoing) {
+            update_stats(false, view.length, 0);
+            return 1;
+        }
+    }
+}
+
+void FastComms::enable_rx_timestamps() {
+    if (rx_timestamps_enabled_) {
+        return;
+    }
+    
+    int enable = 1;
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0) {
+        std::cerr << "Warning: Kernel RX timestamps unavailable" << std::endl;
+    }
+    rx_timestamps_enabled_ = true;
+}
+
+void FastComms::prepare_rx_batch(ReceiveBatch& batch, size_t count) {
+    if (rx_msgs_.size() < count) {
+        rx_msgs_.resize(count);
+        rx_iovs_.resize(count);
+        rx_addrs_.resize(count);
+        rx_control_.resize(count * kRxControlSize);
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        rx_iovs_[i].iov_base = batch.buffer.data() + i * batch.slot_size;
+        rx_iovs_[i].iov_len = batch.slot_size;
+        
+        memset(&rx_msgs_[i], 0, sizeof(rx_msgs_[i]));
+        rx_msgs_[i].msg_hdr.msg_iov = &rx_iovs_[i];
+        rx_msgs_[i].msg_hdr.msg_iovlen = 1;
+        rx_msgs_[i].msg_hdr.msg_name = &rx_addrs_[i];
+        rx_msgs_[i].msg_hdr.msg_namelen = sizeof(rx_addrs_[i]);
+        rx_msgs_[i].msg_hdr.msg_control = rx_control_.data() + i * kRxControlSize;
+        rx_msgs_[i].msg_hdr.msg_controllen = kRxControlSize;
+    }
+}
+
+uint64_t FastComms::rx_timestamp_ns(const struct msghdr& msg, uint64_t fallback_ns,
+                                   bool* hardware) {
+    uint64_t software_ns = 0;
+    uint64_t hardware_ns = 0;
+    
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(const_cast<struct msghdr*>(&msg));
+         cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&msg), cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS && software_ns == 0) {
+            struct timespec ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            software_ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            // ts[0] is the system clock, ts[2] the raw NIC clock
+            struct scm_timestamping stamps;
+            memcpy(&stamps, CMSG_DATA(cmsg), sizeof(stamps));
+            uint64_t sw = static_cast<uint64_t>(stamps.ts[0].tv_sec) * 1000000000ULL + stamps.ts[0].tv_nsec;
+            hardware_ns = static_cast<uint64_t>(stamps.ts[2].tv_sec) * 1000000000ULL + stamps.ts[2].tv_nsec;
+            if (sw != 0) {
+                software_ns = sw;
+            }
+        }
+    }
+    
+    if (hardware != nullptr) {
+        *hardware = (hardware_ns != 0);
+    }
+    if (hardware_ns != 0) {
+        return hardware_ns;
+    }
+    return software_ns != 0 ? software_ns : fallback_ns;
+}
+
+void FastComms::collect_kernel_drops() const {
+    if (socket_fd_ < 0) {
+        return;
+    }
+    
+    // tpacket_stats_v3 is a superset of tpacket_stats, so this works in
+    // every TPACKET version
+    struct tpacket_stats_v3 kstats;
+    memset(&kstats, 0, sizeof(kstats));
+    socklen_t len = sizeof(kstats);
+    uint64_t drops = 0;
+    
+    if (getsockopt(socket_fd_, SOL_PACKET, PACKET_STATISTICS, &kstats, &len) == 0) {
+        drops += kstats.tp_drops;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(xdp_mutex_);
+        drops += xsk_.take_drops();
+    }
+    kernel_drops_.fetch_add(drops, std::memory_order_relaxed);
+}
+
+int FastComms::socket_burst_send(const std::vector<ByteSpan>& packets,
+                                 uint8_t* accepted) {
+    int sent_count = 0;
+    
+    for (size_t i = 0; i < packets.size(); i++) {
+        if (send_packet(packets[i])) {
+            if (accepted) {
+                accepted[i] = 1;
+            }
+            sent_count++;
+        }
+    }
+    
+    return sent_count;
+}
+
+int FastComms::ring_burst_send(const std::vector<ByteSpan>& packets,
+                               uint8_t* accepted) {
+    if (!initialized_ || socket_fd_ < 0) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    
+    int sent_count = 0;
+    uint64_t bytes = 0;
+    
+    // The ring kicks itself when it fills up; one final kick for the tail
+    for (size_t i = 0; i < packets.size(); i++) {
+        if (ring_.tx_enqueue(packets[i].data(), packets[i].size())) {
+            if (accepted) {
+                accepted[i] = 1;
+            }
+            sent_count++;
+            bytes += packets[i].size();
+            capture_tx(packets[i]);
+        } else {
+            count_errors(1);
+        }
+    }
+    
+    if (ring_.tx_flush(false) < 0) {
+        count_errors(1);
+    }
+    
+    count_sent(sent_count, bytes);
+    
+    return sent_count;
+}
+
+int FastComms::batched_burst_send(const std::vector<ByteSpan>& packets,
+                                  uint8_t* accepted) {
+    if (!initialized_ || socket_fd_ < 0) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+    
+    int sent_count = 0;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    size_t next = 0;
+    
+    while (next < packets.size()) {
+        size_t batch = prepare_tx_batch(std::min<size_t>(tx_batch_size_, packets.size() - next));
+        for (size_t i = 0; i < batch; i++) {
+            const ByteSpan& packet = packets[next + i];
+            tx_iovs_[i].iov_base = const_cast<uint8_t*>(packet.data());
+            tx_iovs_[i].iov_len = packet.size();
+        }
+        
+        int sent = sendmmsg(socket_fd_, tx_msgs_.data(), batch, 0);
+        
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // sendmmsg reports the error of the first unsent frame; skip it
+            errors++;
+            next++;
+            continue;
+        }
+        
+        for (int i = 0; i < sent; i++) {
+            if (accepted) {
+                accepted[next + i] = 1;
+            }
+            bytes += tx_msgs_[i].msg_len;
+            capture_tx(packets[next + i]);
+        }
+        sent_count += sent;
+        next += sent;
+    }
+    
+    count_sent(sent_count, bytes);
+    count_errors(errors);
+    
+    return sent_count;
+}
+
+int FastComms::xdp_burst_send(const std::vector<ByteSpan>& packets,
+                              uint8_t* accepted) {
+    if (!initialized_ || !xsk_.is_open()) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(xdp_mutex_);
+    
+    int sent_count = 0;
+    uint64_t bytes = 0;
+    
+    // send() wakes the kernel itself when UMEM or the TX ring runs out
+    for (size_t i = 0; i < packets.size(); i++) {
+        if (xsk_.send(packets[i].data(), packets[i].size())) {
+            if (accepted) {
+                accepted[i] = 1;
+            }
+            sent_count++;
+            bytes += packets[i].size();
+            capture_tx(packets[i]);
+        } else {
+            count_errors(1);
+        }
+    }
+    
+    if (xsk_.kick() < 0) {
+        count_errors(1);
+    }
+    
+    count_sent(sent_count, bytes);
+    
+    return sent_count;
+}
+
+int FastComms::uring_burst_send(const std::vector<ByteSpan>& packets,
+                                uint8_t* accepted) {
+    std::unique_lock<std::mutex> lock(tx_mutex_);
+    
+    if (!initialized_) {
+        return 0;
+    }
+    if (!uring_ready()) {
+        // The ring could not be set up again after a failure
+        lock.unlock();
+        return socket_burst_send(packets, accepted);
+    }
+    
+    // Completions of an earlier call carry another tag and are skipped
+    uint64_t tag = static_cast<uint64_t>(++uring_call_) << kUringTagShift;
+    int sent_count = 0;
+    uint64_t bytes = 0;
+    size_t next = 0;
+    size_t completed = 0;
+    std::vector<IoCompletion> completions;
+    
+    while (completed < packets.size()) {
+        while (next < packets.size() &&
+               uring_.queue_send(socket_fd_, packets[next].data(), packets[next].size(),
+                                 tag | next)) {
+            next++;
+        }
+        
+        if (uring_.submit(1) < 0) {
+            reset_uring();
+            count_errors(1);
+            break;
+        }
+        
+        completions.clear();
+        uring_.reap(completions, kUringDepth);
+        
+        for (const IoCompletion& completion : completions) {
+            size_t index = static_cast<size_t>(completion.user_data & kUringIndexMask);
+            if ((completion.user_data & ~kUringIndexMask) != tag || index >= packets.size()) {
+                continue;
+            }
+            completed++;
+            if (completion.result >= 0) {
+                if (accepted) {
+                    accepted[index] = 1;
+                }
+                sent_count++;
+                bytes += completion.result;
+                capture_tx(packets[index]);
+            } else {
+                count_errors(1);
+            }
+        }
+    }
+    
+    count_sent(sent_count, bytes);
+    
+    return sent_count;
+}
+
+bool FastComms::uring_ready() {
+    if (!uring_.is_open() && !uring_attempted_) {
+        uring_attempted_ = true;
+        uring_.setup(kUringDepth);
+    }
+    return uring_.is_open();
+}
+
+void FastComms::reset_uring() {
+    // A failed submit leaves the queues in an unknown state; the next
+    // caller sets up a fresh ring instead of finding it closed for good
+    std::cerr << "Warning: io_uring submission failed, the ring will be set up again"
+              << std::endl;
+    uring_.close();
+    uring_attempted_ = false;
+}
+
+size_t FastComms::prepare_tx_batch(size_t count) {
+    if (tx_msgs_.size() < count) {
+        tx_msgs_.resize(count);
+        tx_iovs_.resize(count);
+    }
+    
+    // Re-link every header; a previous batch may have grown the vectors
+    for (size_t i = 0; i < count; i++) {
+        memset(&tx_msgs_[i], 0, sizeof(tx_msgs_[i]));
+        tx_msgs_[i].msg_hdr.msg_iov = &tx_iovs_[i];
+        tx_msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+    
+    return count;
+}
+
+const char* FastComms::tx_mode_name(TxMode mode) {
+    switch (mode) {
+        case TxMode::MMAP_RING:
+            return "mmap-ring";
+        case TxMode::SENDMMSG:
+            return "sendmmsg";
+        case TxMode::XDP:
+            return "af-xdp";
+        case TxMode::IO_URING:
+            return "io-uring";
+        default:
+            return "socket";
+    }
+}
+
+void FastComms::update_stats(bool sent, size_t bytes, uint64_t latency_us) {
+    if (sent) {
+        count_sent(1, bytes);
+    } else {
+        count_received(1, bytes);
+    }
+    
+    if (latency_us > 0) {
+        StatsShard& shard = local_shard();
+        shard.latency_sum_us.fetch_add(latency_us, std::memory_order_relaxed);
+        shard.latency_samples.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FastComms::record_round_trip(uint64_t latency_ns) {
+    round_trips_.record(latency_ns);
+}
+
+void FastComms::capture_rx(const PacketView& view) {
+    // Outgoing frames are recorded where they are sent, if at all
+    if (capture_ && !view.outgoing && capture_->is_open()) {
+        uint64_t timestamp_ns = view.timestamp_ns ? view.timestamp_ns : get_timestamp_ns();
+        capture_->write(ByteSpan(view.data, view.length), timestamp_ns, false);
+    }
+}
+
+void FastComms::capture_tx(ByteSpan frame) {
+    if (capture_ && capture_transmit_ && capture_->is_open()) {
+        capture_->write(frame, get_timestamp_ns(), true);
+    }
+}
+
+void FastComms::count_sent(uint64_t packets, uint64_t bytes) {
+    StatsShard& shard = local_shard();
+    shard.packets_sent.fetch_add(packets, std::memory_order_relaxed);
+    shard.bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void FastComms::count_received(uint64_t packets, uint64_t bytes) {
+    StatsShard& shard = local_shard();
+    shard.packets_received.fetch_add(packets, std::memory_order_relaxed);
+    shard.bytes_received.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void FastComms::count_errors(uint64_t errors) {
+    local_shard().errors.fetch_add(errors, std::memory_order_relaxed);
+}
+
+FastComms::StatsShard& FastComms::local_shard() {
+    // Threads take shards round-robin the first time they touch any channel
+    static std::atomic<size_t> next_shard(0);
+    static thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+    return stats_shards_[shard % kStatsShards];
+}
+
+void FastComms::StatsShard::reset() {
+    packets_sent.store(0, std::memory_order_relaxed);
+    packets_received.store(0, std::memory_order_relaxed);
+    bytes_sent.store(0, std::memory_order_relaxed);
+    bytes_received.store(0, std::memory_order_relaxed);
+    errors.store(0, std::memory_order_relaxed);
+    latency_sum_us.store(0, std::memory_order_relaxed);
+    latency_samples.store(0, std::memory_order_relaxed);
+}
+
+uint64_t FastComms::get_timestamp_us() {
+    auto now = std::chrono::high_resolution_clock::now();
+    auto duration = now.time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+uint64_t FastComms::get_timestamp_ns() {
+    auto now = std::chrono::high_resolution_clock::now();
+    auto duration = now.time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+// PacketValidator Implementation
+
+uint32_t PacketValidator::calculate_crc32(ByteSpan data) {
+    return crc32_update(0, data.data(), data.size());
+}
+
+bool PacketValidator::verify_packet(ByteSpan packet, uint32_t expected_crc) {
+    return calculate_crc32(packet) == expected_crc;
+}
+
+uint16_t PacketValidator::calculate_simple_checksum(ByteSpan data) {
+    return inet_checksum(data.data(), data.size());
+}
+
+uint16_t PacketValidator::update_checksum(uint16_t checksum, ByteSpan old_field, ByteSpan new_field) {
+    if (old_field.size() != new_field.size()) {
+        std::cerr << "Warning: update_checksum needs fields of equal length ("
+                  << old_field.size() << " vs " << new_field.size()
+                  << "), checksum left unchanged" << std::endl;
+        return checksum;
+    }
+    return inet_checksum_adjust(checksum, old_field.data(), new_field.data(), old_field.size());
+}
+
+// Frames below this many per worker are not worth a thread
+static const size_t kValidateFramesPerThread = 4096;
+
+static bool trailer_valid(const uint8_t* frame, uint32_t length, IntegrityCheck check) {
+    if (check == IntegrityCheck::CHECKSUM16) {
+        if (length < 2) {
+            return false;
+        }
+        uint16_t trailer = static_cast<uint16_t>((frame[length - 2] << 8) | frame[length - 1]);
+        return inet_checksum(frame, length - 2) == trailer;
+    }
+    
+    if (length < 4) {
+        return false;
+    }
+    const uint8_t* t = frame + length - 4;
+    uint32_t trailer = check == IntegrityCheck::CRC32
+        ? static_cast<uint32_t>(t[0]) | (static_cast<uint32_t>(t[1]) << 8) |
+          (static_cast<uint32_t>(t[2]) << 16) | (static_cast<uint32_t>(t[3]) << 24)
+        : (static_cast<uint32_t>(t[0]) << 24) | (static_cast<uint32_t>(t[1]) << 16) |
+          (static_cast<uint32_t>(t[2]) << 8) | static_cast<uint32_t>(t[3]);
+    return crc32_update(0, frame, length - 4) == trailer;
+}
+
+// Frames [first, last) into bitmap words; first is a multiple of 64, so
+// workers never share a word
+static size_t validate_range(ByteSpan buffer, const uint64_t* offsets, const uint32_t* lengths,
+                             size_t first, size_t last, IntegrityCheck check, uint64_t* bitmap) {
+    size_t failures = 0;
+    for (size_t i = first; i < last; i++) {
+        bool valid = offsets[i] <= buffer.size() && lengths[i] <= buffer.size() - offsets[i] &&
+                     trailer_valid(buffer.data() + offsets[i], lengths[i], check);
+        if (!valid) {
+            bitmap[i / 64] |= 1ULL << (i % 64);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+BatchValidation PacketValidator::validate_batch(ByteSpan buffer, const uint64_t* offsets,
+                                                const uint32_t* lengths, size_t count,
+                                                IntegrityCheck check, unsigned threads) {
+    BatchValidation result;
+    result.frames = count;
+    result.failure_bitmap.assign((count + 63) / 64, 0);
+    
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    size_t workers = std::min<size_t>(threads, count / kValidateFramesPerThread);
+    if (workers <= 1) {
+        result.failures = validate_range(buffer, offsets, lengths, 0, count, check,
+                                         result.failure_bitmap.data());
+        return result;
+    }
+    
+    // Whole bitmap words per worker; the caller's thread takes the first range
+    size_t words = result.failure_bitmap.size();
+    size_t words_per_worker = (words + workers - 1) / workers;
+    std::vector<size_t> failures(workers, 0);
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    
+    for (size_t w = 1; w < workers; w++) {
+        size_t first = std::min(count, w * words_per_worker * 64);
+        size_t last = std::min(count, (w + 1) * words_per_worker * 64);
+        pool.emplace_back([&, w, first, last]() {
+            failures[w] = validate_range(buffer, offsets, lengths, first, last, check,
+                                         result.failure_bitmap.data());
+        });
+    }
+    failures[0] = validate_range(buffer, offsets, lengths, 0,
+                                 std::min(count, words_per_worker * 64), check,
+                                 result.failure_bitmap.data());
+    for (std::thread& worker : pool) {
+        worker.join();
+    }
+    
+    for (size_t f : failures) {
+        result.failures += f;
+    }
+    return result;
+}
+
+BatchValidation PacketValidator::validate_batch(const ReceiveBatch& batch, IntegrityCheck check,
+                                                unsigned threads) {
+    std::vector<uint64_t> offsets(batch.count());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        offsets[i] = static_cast<uint64_t>(i) * batch.slot_size;
+    }
+    return validate_batch(ByteSpan(batch.buffer), offsets.data(), batch.lengths.data(),
+                          batch.count(), check, threads);
 }
 
 // PerformanceMonitor Implementation
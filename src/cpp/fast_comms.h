@@ -15,7 +15,22 @@
 #include <cstdint>
 #include <vector>
 #include <string>
+#include <functional>
 #include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/if_packet.h>
+#include "packet_ring.h"
+#include "xdp_socket.h"
+#include "io_uring_engine.h"
+#include "packet_pool.h"
+#include "packet_filter.h"
+#include "latency_histogram.h"
+#include "pcapng_writer.h"
 
 namespace embedded_test {
     //Packet statistics structure
@@ -25,23 +40,113 @@ namespace embedded_test {
     uint64_t bytes_sent;
     uint64_t bytes_received;
     uint64_t errors;
-    double avg_latency_us;  // microseconds
+    uint64_t kernel_drops;  // frames the kernel dropped before we could read them
+    double avg_latency_us;  // mean over all timed operations, microseconds
+    LatencyHistogram latency;   // request/response round trips, nanoseconds
     
     PacketStats() : packets_sent(0), packets_received(0), 
                     bytes_sent(0), bytes_received(0), 
-                    errors(0), avg_latency_us(0.0) {}
+                    errors(0), kernel_drops(0), avg_latency_us(0.0) {}
 };
 //Communication result
 struct CommResult {
     bool success;
     std::vector<uint8_t> data;
     uint64_t latency_us;
+    uint64_t latency_ns;        // from kernel timestamps when timestamping is enabled
+    uint64_t tx_timestamp_ns;   // kernel TX timestamp of the request, 0 if none
+    uint64_t rx_timestamp_ns;   // RX timestamp of the response, 0 if none
     std::string error_message;
     
-    CommResult() : success(false), latency_us(0) {}
+    CommResult() : success(false), latency_us(0), latency_ns(0),
+                   tx_timestamp_ns(0), rx_timestamp_ns(0) {}
 };
 
+//Settings for stress_test_parallel
+
+struct StressConfig {
+    uint32_t threads;           // transmit workers (one socket each)
+    std::vector<int> cpus;      // CPU per worker; empty pins worker i to CPU i
+    size_t packet_size;         // size of the 0xAA filler frame if frame is empty
+    std::vector<uint8_t> frame; // prebuilt frame every worker sends
+    bool qdisc_bypass;          // PACKET_QDISC_BYPASS on the worker sockets
+    
+    StressConfig() : threads(4), packet_size(64), qdisc_bypass(true) {}
+};
+
+//Result of stress_test_parallel
+
+struct StressResult {
+    PacketStats total;                  // summed over the workers
+    std::vector<PacketStats> per_thread;
+    double elapsed_s;
+    double pps;
+    double mbps;
+    
+    StressResult() : elapsed_s(0), pps(0), mbps(0) {}
+};
+
+//Batch of received frames
+//Frame i occupies slot i of buffer (slot_size bytes each); reuse the same
+//object across calls so the storage is allocated only once
+
+struct ReceiveBatch {
+    std::vector<uint8_t> buffer;
+    std::vector<uint32_t> lengths;
+    std::vector<uint64_t> timestamps_ns;
+    size_t slot_size;
+    
+    ReceiveBatch() : slot_size(0) {}
+    
+    size_t count() const { return lengths.size(); }
+    const uint8_t* frame(size_t index) const { return buffer.data() + index * slot_size; }
+};
+
+//Pulls the pairing key out of a request or response frame
+//param frame Whole frame as sent or received
+//param key Set to the key when the frame carries one
+//return false if the frame has no key (such responses are ignored)
+
+typedef std::function<bool(ByteSpan frame, uint32_t& key)> ResponseMatcher;
+
+//Settings for FastComms::send_and_receive_pipelined
+
+struct PipelineConfig {
+    uint32_t window;            // requests kept in flight
+    uint32_t timeout_ms;        // per-request response timeout
+    uint32_t header_offset;     // AA55 header position (14 = after the Ethernet header)
+    ResponseMatcher matcher;    // replaces the AA55 SEQ matcher when set
+    
+    PipelineConfig() : window(32), timeout_ms(1000), header_offset(14) {}
+};
+
+//Transmit path selection
+
+enum class TxMode {
+    SOCKET,     // one send() syscall per frame
+    MMAP_RING,  // PACKET_MMAP TX ring, one kick per batch
+    SENDMMSG,   // sendmmsg(), up to tx_batch_size frames per syscall
+    XDP,        // AF_XDP socket, frames copied into UMEM
+    IO_URING    // sends queued on io_uring, one io_uring_enter() per batch
+};
+
+//Receive path selection
+
+enum class RxMode {
+    SOCKET,     // one recv() syscall per frame
+    MMAP_RING,  // TPACKET_V3 RX ring, frames read in place
+    XDP         // AF_XDP socket, frames read in place from UMEM
+};
+
+//Pin the calling thread to one CPU
+//param cpu CPU index (taken modulo the number of CPUs)
+//return true if successful
+
+bool pin_thread_to_cpu(int cpu);
+
 //Fast communication handler
+//Send and receive calls may come from several threads at once;
+//initialize(), close() and the set_* calls must not overlap with them
 
 class FastComms {
 public:
@@ -53,9 +158,11 @@ FastComms(const std::string& interface_name, uint32_t timeout_ms = 1000);
 ~FastComms();
 
 //Initialize the communication channel
+//param tx_mode Transmit path; falls back to SOCKET if it cannot be set up
+//param rx_mode Receive path; falls back to SOCKET if it cannot be set up
 //return true if successful
 
-bool initialize();
+bool initialize(TxMode tx_mode = TxMode::SOCKET, RxMode rx_mode = RxMode::SOCKET);
 
 //Close the communication channel
 
@@ -65,7 +172,7 @@ void close();
 //param data Packet data
 //return true if sent successfully
 
-bool send_packet(const std::vector<uint8_t>& data);
+bool send_packet(ByteSpan data);
 
 //Receive raw packet with timeout
 //param buffer Buffer to store received data
@@ -74,13 +181,88 @@ bool send_packet(const std::vector<uint8_t>& data);
 
 int receive_packet(std::vector<uint8_t>& buffer, size_t max_size = 4096);
 
+//Receive raw packet into a pooled buffer (no allocation, no zero-fill)
+//param buffer Buffer acquired from a PacketPool; size and timestamp are set
+//return Number of bytes received, 0 on timeout, -1 on error
+
+int receive_packet(PacketBuffer& buffer);
+
+//Receive raw packet without copying (MMAP_RING and XDP RX modes only)
+//The view stays valid only while no other receive advances the ring, so
+//the first thread to call this becomes the channel's only receiver:
+//receive calls from any other thread fail with -1 until close()
+//param view Points into the RX ring or UMEM; valid until the next receive call
+//return Number of bytes received, 0 on timeout, -1 on error
+
+int receive_view(PacketView& view);
+
+//Receive up to max_frames frames with one recvmmsg() call
+//Waits up to timeout_ms for the first frame, then takes whatever is queued
+//param batch Output batch (storage is reused between calls)
+//param max_frames Maximum number of frames to return
+//param timeout_ms Time to wait for the first frame
+//param max_frame_size Slot size; longer frames are truncated
+//return Number of frames received, 0 on timeout, -1 on error
+
+int receive_batch(ReceiveBatch& batch, size_t max_frames, uint32_t timeout_ms,
+                  size_t max_frame_size = 2048);
+
+//Take one frame if it is already queued, without waiting
+//Used by event loops that drain a channel until it runs dry
+//param view Points into a buffer owned by the calling thread; valid until
+//that thread's next try_receive call
+//return Number of bytes received, 0 if nothing is queued, -1 on error
+
+int try_receive(PacketView& view);
+
 //Send packet and wait for response
+//Frames this host transmitted (seen on the raw socket) are skipped
 //param request Request data
 //param response Buffer for response
 //return Communication result with latency
 
-CommResult send_and_receive(const std::vector<uint8_t>& request, 
-                                 std::vector<uint8_t>& response);
+CommResult send_and_receive(ByteSpan request, std::vector<uint8_t>& response);
+
+//Send packet and wait for a response delivered into a pooled buffer
+//result.data is left empty; the response is only in the buffer
+//param request Request data
+//param response Buffer acquired from a PacketPool
+//return Communication result with latency
+
+CommResult send_and_receive(ByteSpan request, PacketBuffer& response);
+
+//Send many requests and wait for responses with all of them in flight
+//Uses io_uring with a linked timeout per receive when available,
+//otherwise falls back to sequential send_and_receive. Responses are
+//matched by AA55 SEQ (header after the Ethernet header) and frames this
+//host transmitted are skipped; if any request has no AA55 header the
+//batch runs one request at a time
+//param requests Request data
+//param results One result per request
+//return Number of successful transactions
+
+int send_and_receive_batch(const std::vector<ByteSpan>& requests,
+                           std::vector<CommResult>& results);
+
+int send_and_receive_batch(const std::vector<std::vector<uint8_t>>& requests,
+                           std::vector<CommResult>& results);
+
+//Keep up to config.window requests in flight and pair responses by key
+//Responses may arrive in any order; by default they are matched on the
+//AA55 SEQ field. Our own transmitted frames are ignored and each request
+//times out on its own. Holds the receive side for the whole call
+//param requests Request data (each key must be unique within the window)
+//param results One result per request, in request order
+//param config Window, timeout and matching settings
+//return Number of successful transactions
+
+int send_and_receive_pipelined(const std::vector<ByteSpan>& requests,
+                               std::vector<CommResult>& results,
+                               const PipelineConfig& config = PipelineConfig());
+
+int send_and_receive_pipelined(const std::vector<std::vector<uint8_t>>& requests,
+                               std::vector<CommResult>& results,
+                               const PipelineConfig& config = PipelineConfig());
 
 //Burst send multiple packets
 //Optimized for high-throughput scenarios
@@ -89,12 +271,35 @@ CommResult send_and_receive(const std::vector<uint8_t>& request,
 
 int burst_send(const std::vector<std::vector<uint8_t>>& packets);
 
+//Burst send frames held in caller-owned memory (no per-frame copy)
+//param packets Views of the frames to send
+//return Number of packets successfully sent
+
+int burst_send(const std::vector<ByteSpan>& packets);
+
+//Burst send with per-frame status
+//param packets Vector of packets to send
+//param accepted Set to 1 for each frame the kernel accepted, 0 otherwise
+//return Number of packets successfully sent
+
+int burst_send(const std::vector<std::vector<uint8_t>>& packets,
+               std::vector<uint8_t>& accepted);
+
+int burst_send(const std::vector<ByteSpan>& packets, std::vector<uint8_t>& accepted);
+
 //Measure round-trip latency
 //Sends ping packet and measures response time
 //param payload Ping payload
 //return Latency in microseconds, -1 on error
 
-int64_t measure_latency(const std::vector<uint8_t>& payload);
+int64_t measure_latency(ByteSpan payload);
+
+//Measure round-trip latency with nanosecond resolution
+//Uses kernel timestamps when enable_timestamping() is on
+//param payload Ping payload
+//return Latency in nanoseconds, -1 on error
+
+int64_t measure_latency_ns(ByteSpan payload);
 
 //Stress test - send packets at maximum rate
 //param duration_ms Duration in milliseconds
@@ -103,6 +308,21 @@ int64_t measure_latency(const std::vector<uint8_t>& payload);
 
 PacketStats stress_test(uint32_t duration_ms, size_t packet_size = 64);
 
+//Stress test with several transmit threads
+//Each worker gets its own transmit-only socket (same TX mode as this
+//channel), is pinned to a CPU and sends a prebuilt frame until the time is
+//up or stop_stress_test() is called. The totals are added to this
+//channel's statistics
+//param duration_ms Duration in milliseconds
+//param config Workers, pinning and frame
+//return Aggregate and per-thread statistics
+
+StressResult stress_test_parallel(uint32_t duration_ms, const StressConfig& config = StressConfig());
+
+//Make a running stress test return early (safe from any thread)
+
+void stop_stress_test();
+
 //Get communication statistics
 //return Current statistics
 
@@ -122,18 +342,265 @@ void set_timeout(uint32_t timeout_ms);
 
 bool is_ready() const;
 
+//Get the descriptor that becomes readable when frames arrive
+//return AF_XDP socket in RxMode::XDP, raw socket otherwise, -1 if closed
+
+int get_fd() const;
+
+//Get the active transmit path
+//return TxMode selected at initialize()
+
+TxMode get_tx_mode() const;
+
+//Get the active receive path
+//return RxMode selected at initialize()
+
+RxMode get_rx_mode() const;
+
+//Set the kernel socket receive buffer size
+//Absorbs bursts between receive calls in socket RX mode
+//param bytes Buffer size in bytes
+//return true if successful
+
+bool set_receive_buffer_size(uint32_t bytes);
+
+//Set the number of frames submitted per sendmmsg() call
+//param batch_size Frames per syscall (clamped to 1..UIO_MAXIOV)
+
+void set_tx_batch_size(uint32_t batch_size);
+
+//Set AF_XDP socket options (queue, UMEM size, copy/zero-copy)
+//Takes effect at the next initialize()
+//param config AF_XDP settings
+
+void set_xdp_config(const XdpConfig& config);
+
+//Check whether the AF_XDP socket is running in zero-copy mode
+//return true if zero-copy
+
+bool is_xdp_zero_copy() const;
+
+//Set how long the kernel holds a partly filled RX block
+//Takes effect at the next initialize()
+//param timeout_ms Block retire timeout in milliseconds
+
+void set_rx_block_timeout(uint32_t timeout_ms);
+
+//Set the range and precision of the round-trip latency histogram
+//Memory is fixed by the layout and allocated here, never while recording.
+//Clears the recorded latencies; must not overlap with traffic
+//param config Range (ns) and significant digits
+
+void set_latency_histogram(const HistogramConfig& config);
+
+//Hand frames straight to the driver, skipping the qdisc layer
+//(PACKET_QDISC_BYPASS). Faster, but frames are dropped instead of queued
+//when the driver queue is full. Takes effect at the next initialize()
+//param enable true to bypass the qdisc
+
+void set_qdisc_bypass(bool enable);
+
+//Open the socket for sending only (protocol 0), so the kernel queues no
+//received frames on it. Takes effect at the next initialize()
+//param enable true for a transmit-only socket
+
+void set_transmit_only(bool enable);
+
+//Have the kernel drop every frame that does not match expression
+//Compiled to classic BPF and attached with SO_ATTACH_FILTER, so unwanted
+//traffic costs no copy or wakeup. Can be replaced at any time and is
+//re-attached by initialize(). Applies to SOCKET and MMAP_RING receive,
+//not to XDP
+//param expression Match expression (see PacketFilter), "" to accept all
+//return false if the expression is invalid or cannot be attached
+
+bool set_filter(const std::string& expression);
+
+//Remove the receive filter
+
+void clear_filter();
+
+//Get the active filter expression
+//return Expression, empty if none
+
+std::string get_filter() const;
+
+//Timestamp send_and_receive traffic in the kernel (SO_TIMESTAMPING)
+//The request's TX time is read from the socket error queue and the
+//response's RX time from the receive path, so latency excludes syscall
+//and scheduler noise. Stays on across initialize(). In MMAP_RING and XDP
+//transmit modes requests go out through the ring, which has no per-send
+//TX stamp, so latency falls back to the user-space clock
+//param hardware Also try NIC timestamps (SIOCSHWTSTAMP); software
+//timestamps are used if the driver refuses
+//return true if timestamping is active
+
+bool enable_timestamping(bool hardware = false);
+
+//Check whether NIC (hardware) timestamps are in use
+//return true if the driver accepted hardware timestamping
+
+bool has_hardware_timestamps() const;
+
+//Record traffic to a pcapng file (nanosecond timestamps)
+//Frames from every receive path are recorded, except the copies of
+//outgoing frames the socket sees. With config.transmit, frames sent by
+//send_packet, burst_send and the request/response calls are recorded too;
+//stress tests never are. A background thread writes the file, so frames
+//that do not fit in its buffers are dropped and counted, never waited for.
+//Like the set_* calls, must not overlap with traffic
+//param config File path, rotation and buffering
+//return true if the capture file was created
+
+bool start_capture(const CaptureConfig& config);
+
+//Flush and close the capture file
+
+void stop_capture();
+
+//Check whether a capture is running
+
+bool is_capturing() const;
+
+//Get capture counters (frames written, dropped, files)
+//return Counters of the current or last capture
+
+CaptureStats get_capture_statistics() const;
+
 private:
     std::string interface_name_;
     uint32_t timeout_ms_;
     int socket_fd_;
     bool initialized_;
-    PacketStats stats_;
+    
+    // Per-thread slice of the counters. Threads are spread over the shards
+    // so concurrent senders and receivers do not bounce one cache line;
+    // get_statistics() sums them
+    struct StatsShard {
+        std::atomic<uint64_t> packets_sent;
+        std::atomic<uint64_t> packets_received;
+        std::atomic<uint64_t> bytes_sent;
+        std::atomic<uint64_t> bytes_received;
+        std::atomic<uint64_t> errors;
+        std::atomic<uint64_t> latency_sum_us;
+        std::atomic<uint64_t> latency_samples;
+        // 56 bytes of counters + 72 of padding keeps the counters of
+        // neighbouring shards more than a cache line apart at any alignment
+        char padding[72];
+        
+        StatsShard() { reset(); }
+        void reset();
+    };
+    
+    static const size_t kStatsShards = 16;
+    StatsShard stats_shards_[kStatsShards];
+    mutable std::atomic<uint64_t> kernel_drops_;
+    
+    // One histogram for all threads: recording is a relaxed fetch_add, and
+    // a copy per shard cost 16 times the memory and merge work per channel
+    AtomicLatencyHistogram round_trips_;
+    
+    // Plain socket send()/recv() need no locking. These serialize the paths
+    // that keep user-space state: TX ring, sendmmsg headers and io_uring
+    // (tx), RX ring and receive scratch buffers (rx), and the AF_XDP socket
+    // whose UMEM both directions share (xdp). Lock order: rx before xdp
+    std::mutex tx_mutex_;
+    std::mutex rx_mutex_;
+    mutable std::mutex xdp_mutex_;
+    TxMode tx_mode_;
+    RxMode rx_mode_;
+    PacketFilter filter_;
+    RingConfig ring_config_;
+    PacketRing ring_;
+    XdpConfig xdp_config_;
+    XdpSocket xsk_;
+    IoUringEngine uring_;
+    bool uring_attempted_;
+    uint16_t uring_call_;       // tags user_data so stale completions are recognised
+    uint32_t tx_batch_size_;
+    std::vector<struct mmsghdr> tx_msgs_;
+    std::vector<struct iovec> tx_iovs_;
+    std::vector<struct mmsghdr> rx_msgs_;
+    std::vector<struct iovec> rx_iovs_;
+    std::vector<uint8_t> rx_control_;
+    std::vector<uint8_t> rx_scratch_;
+    bool rx_timestamps_enabled_;
+    std::thread::id view_owner_;    // sole receiver once receive_view has been used (rx)
+    bool view_owner_warned_;
+    bool timestamping_;             // SO_TIMESTAMPING requested
+    bool hardware_requested_;
+    bool hardware_timestamps_;      // driver accepted SIOCSHWTSTAMP
+    std::unique_ptr<PcapngWriter> capture_;
+    bool capture_transmit_;
+    std::vector<struct sockaddr_ll> rx_addrs_;
+    bool qdisc_bypass_;
+    bool transmit_only_;
+    std::atomic<bool> stress_stop_;
     
     // Helper methods
+    PacketStats run_stress(ByteSpan frame, uint64_t end_time, const std::atomic<bool>& stop);
     int create_raw_socket();
     int bind_to_interface();
+    bool setup_rings(bool tx, bool rx);
+    void collect_kernel_drops() const;
+    int socket_burst_send(const std::vector<ByteSpan>& packets, uint8_t* accepted);
+    int ring_burst_send(const std::vector<ByteSpan>& packets, uint8_t* accepted);
+    int batched_burst_send(const std::vector<ByteSpan>& packets, uint8_t* accepted);
+    int xdp_burst_send(const std::vector<ByteSpan>& packets, uint8_t* accepted);
+    int uring_burst_send(const std::vector<ByteSpan>& packets, uint8_t* accepted);
+    bool uring_ready();
+    void reset_uring();
+    size_t prepare_tx_batch(size_t count);
+    static const char* tx_mode_name(TxMode mode);
+    bool in_place_rx() const;
+    bool poll_view(PacketView& view);
+    int next_view(PacketView& view, uint32_t timeout_ms);
+    int wait_readable(uint32_t timeout_ms);
+    int receive_into(uint8_t* buffer, size_t capacity, PacketView& frame,
+                     bool skip_outgoing);
+    int exchange(ByteSpan request, uint8_t* buffer, size_t capacity, CommResult& result);
+    bool apply_timestamping();
+    bool send_timestamped(ByteSpan data, uint64_t& software_ns, uint64_t& hardware_ns);
+    int read_socket_frame(PacketView& view, std::vector<uint8_t>& storage);
+    bool check_view_owner();
+    int poll_response(PacketView& view);
+    static bool aa55_sequence(ByteSpan frame, size_t header_offset, uint32_t& sequence);
+    void enable_rx_timestamps();
+    void prepare_rx_batch(ReceiveBatch& batch, size_t count);
+    static uint64_t rx_timestamp_ns(const struct msghdr& msg, uint64_t fallback_ns,
+                                    bool* hardware = nullptr);
     void update_stats(bool sent, size_t bytes, uint64_t latency_us);
+    void record_round_trip(uint64_t latency_ns);
+    void capture_rx(const PacketView& view);
+    void capture_tx(ByteSpan frame);
+    void count_sent(uint64_t packets, uint64_t bytes);
+    void count_received(uint64_t packets, uint64_t bytes);
+    void count_errors(uint64_t errors);
+    StatsShard& local_shard();
     uint64_t get_timestamp_us();
+    uint64_t get_timestamp_ns();
+};
+
+//Integrity trailer at the end of each frame, covering the bytes before it
+
+enum class IntegrityCheck {
+    CRC32,          // 4-byte CRC-32, least significant byte first (Ethernet FCS order)
+    CRC32_BE,       // 4-byte CRC-32, network byte order
+    CHECKSUM16      // 2-byte simple checksum, network byte order (AA55 frames)
+};
+
+//Result of PacketValidator::validate_batch
+
+struct BatchValidation {
+    size_t frames;
+    size_t failures;
+    std::vector<uint64_t> failure_bitmap;   // bit i%64 of word i/64 set when frame i failed
+    
+    BatchValidation() : frames(0), failures(0) {}
+    
+    bool failed(size_t index) const {
+        return (failure_bitmap[index / 64] >> (index % 64)) & 1;
+    }
 };
 
 //Packet validator
@@ -142,11 +609,11 @@ private:
 class PacketValidator {
 public:
 
-    //Calculate CRC32 checksum
+    //Calculate CRC32 checksum (PCLMULQDQ or slicing-by-16, see crc32.h)
     //param data Data to checksum
     //return CRC32 value
 
-    static uint32_t calculate_crc32(const std::vector<uint8_t>& data);
+    static uint32_t calculate_crc32(ByteSpan data);
     
     
      //Verify packet integrity
@@ -154,14 +621,50 @@ public:
      //param expected_crc Expected CRC value
      //return true if valid
     
-    static bool verify_packet(const std::vector<uint8_t>& packet, uint32_t expected_crc);
+    static bool verify_packet(ByteSpan packet, uint32_t expected_crc);
     
     
      //Calculate simple checksum (faster but less robust)
+     //Internet checksum of big-endian 16-bit words, SIMD kernel (see inet_checksum.h)
      //param data Data to checksum
      //return Checksum value
     
-    static uint16_t calculate_simple_checksum(const std::vector<uint8_t>& data);
+    static uint16_t calculate_simple_checksum(ByteSpan data);
+    
+    
+     //Update a simple checksum after a field changed, without rereading the packet (RFC 1624)
+     //param checksum Checksum before the change
+     //param old_field Field bytes before the change (starting at an even offset)
+     //param new_field Field bytes after the change, same length
+     //return Checksum after the change
+    
+    static uint16_t update_checksum(uint16_t checksum, ByteSpan old_field, ByteSpan new_field);
+    
+    
+     //Check the integrity trailer of many frames in one call
+     //Frame i is buffer[offsets[i], offsets[i] + lengths[i]); frames that run past
+     //the buffer or are shorter than the trailer count as failures
+     //param buffer Contiguous storage holding every frame
+     //param offsets Start of each frame in buffer
+     //param lengths Length of each frame, trailer included
+     //param count Number of frames
+     //param check Trailer format
+     //param threads Workers, 0 = one per CPU (small batches stay on the caller)
+     //return Failure count and bitmap
+    
+    static BatchValidation validate_batch(ByteSpan buffer, const uint64_t* offsets,
+                                          const uint32_t* lengths, size_t count,
+                                          IntegrityCheck check, unsigned threads = 1);
+    
+    
+     //Check the integrity trailer of every frame in a receive batch
+     //param batch Frames from FastComms::receive_batch
+     //param check Trailer format
+     //param threads Workers, 0 = one per CPU
+     //return Failure count and bitmap
+    
+    static BatchValidation validate_batch(const ReceiveBatch& batch, IntegrityCheck check,
+                                          unsigned threads = 1);
 };
 
 //Performance monitor
@@ -0,0 +1,292 @@
+/**================================================================================
+* FILE: inet_checksum.cpp
+
+* Purpose:
+* 1. Implementation of the Internet checksum kernels and their runtime selection
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "inet_checksum.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CHECKSUM_HAVE_X86 1
+#endif
+
+namespace embedded_test {
+
+// The kernels add native-order 32-bit words into 64-bit accumulators.
+// Since 2^16 == 1 (mod 0xFFFF) that is the same ones-complement sum as
+// adding 16-bit words, and byte order only swaps the two bytes of the
+// folded result (RFC 1071 section 2), so no per-word byte swapping is needed
+
+// Below this AUTO uses the scalar loop
+static const size_t kVectorMinimum = 32;
+
+static inline uint64_t load64(const uint8_t* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t load32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint16_t load16(const uint8_t* p) {
+    uint16_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint16_t fold(uint64_t sum) {
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return static_cast<uint16_t>(sum);
+}
+
+static uint64_t sum_scalar(const uint8_t* p, size_t length) {
+    uint64_t sum = 0;
+    while (length >= 8) {
+        uint64_t words = load64(p);
+        sum += (words & 0xFFFFFFFF) + (words >> 32);
+        p += 8;
+        length -= 8;
+    }
+    if (length >= 4) {
+        sum += load32(p);
+        p += 4;
+        length -= 4;
+    }
+    if (length >= 2) {
+        sum += load16(p);
+        p += 2;
+        length -= 2;
+    }
+    if (length > 0) {
+        // Odd byte is the high byte of a big-endian word
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        sum += *p;
+#else
+        sum += static_cast<uint64_t>(*p) << 8;
+#endif
+    }
+    return sum;
+}
+
+#ifdef CHECKSUM_HAVE_X86
+
+__attribute__((target("sse2")))
+static uint64_t sum_sse2(const uint8_t* p, size_t length) {
+    const __m128i low = _mm_set1_epi64x(0xFFFFFFFF);
+    __m128i a = _mm_setzero_si128();
+    __m128i b = _mm_setzero_si128();
+
+    while (length >= 32) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+        a = _mm_add_epi64(a, _mm_and_si128(x, low));
+        b = _mm_add_epi64(b, _mm_srli_epi64(x, 32));
+        a = _mm_add_epi64(a, _mm_and_si128(y, low));
+        b = _mm_add_epi64(b, _mm_srli_epi64(y, 32));
+        p += 32;
+        length -= 32;
+    }
+
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(a, b));
+    return lanes[0] + lanes[1] + sum_scalar(p, length);
+}
+
+__attribute__((target("avx2")))
+static uint64_t sum_avx2(const uint8_t* p, size_t length) {
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+    __m256i a = _mm256_setzero_si256();
+    __m256i b = _mm256_setzero_si256();
+
+    while (length >= 64) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        a = _mm256_add_epi64(a, _mm256_and_si256(x, low));
+        b = _mm256_add_epi64(b, _mm256_srli_epi64(x, 32));
+        a = _mm256_add_epi64(a, _mm256_and_si256(y, low));
+        b = _mm256_add_epi64(b, _mm256_srli_epi64(y, 32));
+        p += 64;
+        length -= 64;
+    }
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(a, b));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(p, length);
+}
+
+__attribute__((target("avx512f")))
+static uint64_t sum_avx512(const uint8_t* p, size_t length) {
+    const __m512i low = _mm512_set1_epi64(0xFFFFFFFF);
+    __m512i a = _mm512_setzero_si512();
+    __m512i b = _mm512_setzero_si512();
+
+    // maskz_srli is the plain shift; the unmasked intrinsic trips a
+    // GCC 12 -Wmaybe-uninitialized false positive
+    while (length >= 128) {
+        __m512i x = _mm512_loadu_si512(p);
+        __m512i y = _mm512_loadu_si512(p + 64);
+        a = _mm512_add_epi64(a, _mm512_and_si512(x, low));
+        b = _mm512_add_epi64(b, _mm512_maskz_srli_epi64(0xFF, x, 32));
+        a = _mm512_add_epi64(a, _mm512_and_si512(y, low));
+        b = _mm512_add_epi64(b, _mm512_maskz_srli_epi64(0xFF, y, 32));
+        p += 128;
+        length -= 128;
+    }
+
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, _mm512_add_epi64(a, b));
+    uint64_t sum = 0;
+    for (uint64_t lane : lanes) {
+        sum += lane;
+    }
+    return sum + sum_scalar(p, length);
+}
+
+#endif // CHECKSUM_HAVE_X86
+
+typedef uint64_t (*SumFunction)(const uint8_t*, size_t);
+
+static SumFunction kernel_for(ChecksumPath path) {
+    switch (path) {
+#ifdef CHECKSUM_HAVE_X86
+    case ChecksumPath::SSE2:
+        return sum_sse2;
+    case ChecksumPath::AVX2:
+        return sum_avx2;
+    case ChecksumPath::AVX512:
+        return sum_avx512;
+#endif
+    default:
+        return sum_scalar;
+    }
+}
+
+static SumFunction select_widest() {
+    static const ChecksumPath order[] = {
+        ChecksumPath::AVX512, ChecksumPath::AVX2, ChecksumPath::SSE2
+    };
+    for (ChecksumPath path : order) {
+        if (checksum_path_available(path)) {
+            return kernel_for(path);
+        }
+    }
+    return sum_scalar;
+}
+
+uint16_t inet_sum(const uint8_t* data, size_t length, uint16_t initial, ChecksumPath path) {
+    // Chosen once; every later call is one indirect jump
+    static const SumFunction widest = select_widest();
+
+    // A header-sized buffer is done before a vector kernel gets going
+    SumFunction kernel = length < kVectorMinimum ? sum_scalar : widest;
+    if (path != ChecksumPath::AUTO) {
+        kernel = checksum_path_available(path) ? kernel_for(path) : sum_scalar;
+    }
+
+    uint16_t sum = fold(kernel(data, length));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    sum = static_cast<uint16_t>((sum << 8) | (sum >> 8));
+#endif
+    return fold(static_cast<uint64_t>(sum) + initial);
+}
+
+uint16_t inet_checksum(const uint8_t* data, size_t length, ChecksumPath path) {
+    return static_cast<uint16_t>(~inet_sum(data, length, 0, path));
+}
+
+uint16_t inet_checksum_adjust(uint16_t checksum, uint16_t old_word, uint16_t new_word) {
+    // HC' = ~(~HC + ~m + m')
+    uint64_t sum = static_cast<uint16_t>(~checksum);
+    sum += static_cast<uint16_t>(~old_word);
+    sum += new_word;
+    return static_cast<uint16_t>(~fold(sum));
+}
+
+uint16_t inet_checksum_adjust(uint16_t checksum, const uint8_t* old_data,
+                              const uint8_t* new_data, size_t length) {
+    uint64_t sum = static_cast<uint16_t>(~checksum);
+    for (size_t i = 0; i < length; i += 2) {
+        uint16_t old_word = static_cast<uint16_t>(old_data[i] << 8);
+        uint16_t new_word = static_cast<uint16_t>(new_data[i] << 8);
+        // A trailing odd byte changes only the high byte of its word
+        if (i + 1 < length) {
+            old_word |= old_data[i + 1];
+            new_word |= new_data[i + 1];
+        }
+        sum += static_cast<uint16_t>(~old_word);
+        sum += new_word;
+    }
+    return static_cast<uint16_t>(~fold(sum));
+}
+
+#ifdef CHECKSUM_HAVE_X86
+static bool cpu_supports(ChecksumPath path) {
+    __builtin_cpu_init();
+    switch (path) {
+    case ChecksumPath::SSE2:
+        return __builtin_cpu_supports("sse2");
+    case ChecksumPath::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case ChecksumPath::AVX512:
+        return __builtin_cpu_supports("avx512f");
+    default:
+        return true;
+    }
+}
+#endif
+
+bool checksum_path_available(ChecksumPath path) {
+    if (path == ChecksumPath::AUTO || path == ChecksumPath::SCALAR) {
+        return true;
+    }
+#ifdef CHECKSUM_HAVE_X86
+    static const bool sse2 = cpu_supports(ChecksumPath::SSE2);
+    static const bool avx2 = cpu_supports(ChecksumPath::AVX2);
+    static const bool avx512 = cpu_supports(ChecksumPath::AVX512);
+    switch (path) {
+    case ChecksumPath::SSE2:
+        return sse2;
+    case ChecksumPath::AVX2:
+        return avx2;
+    case ChecksumPath::AVX512:
+        return avx512;
+    default:
+        return false;
+    }
+#else
+    return false;
+#endif
+}
+
+const char* checksum_path_name(ChecksumPath path) {
+    switch (path) {
+    case ChecksumPath::SCALAR:
+        return "scalar";
+    case ChecksumPath::SSE2:
+        return "sse2";
+    case ChecksumPath::AVX2:
+        return "avx2";
+    case ChecksumPath::AVX512:
+        return "avx512";
+    case ChecksumPath::AUTO:
+    default:
+        return "auto";
+    }
+}
+
+} // namespace embedded_test
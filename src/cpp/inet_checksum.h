@@ -0,0 +1,86 @@
+/**================================================================================
+* FILE: inet_checksum.h
+
+* Purpose:
+* 1. Internet checksum (RFC 1071 ones-complement sum of 16-bit words)
+* 2. SSE2/AVX2/AVX-512 kernels chosen at runtime, portable scalar fallback
+* 3. Incremental update after a field changes (RFC 1624)
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef INET_CHECKSUM_H
+#define INET_CHECKSUM_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace embedded_test {
+
+//Checksum implementation to use
+
+enum class ChecksumPath {
+    AUTO,           // widest kernel this CPU supports
+    SCALAR,         // 32-bit words into a 64-bit accumulator
+    SSE2,           // 16 bytes per step
+    AVX2,           // 32 bytes per step
+    AVX512          // 64 bytes per step
+};
+
+//Ones-complement sum of big-endian 16-bit words, folded but not inverted
+//An odd final byte counts as the high byte of a word, so only the last
+//piece of a message may have odd length when sums are chained
+//param data Bytes to add
+//param length Number of bytes
+//param initial Folded sum of the preceding data (0 to start)
+//param path Implementation (AUTO unless benchmarking)
+//return Folded 16-bit sum
+
+uint16_t inet_sum(const uint8_t* data, size_t length, uint16_t initial = 0,
+                  ChecksumPath path = ChecksumPath::AUTO);
+
+//Internet checksum: ~inet_sum(data)
+//param data Bytes to checksum
+//param length Number of bytes
+//param path Implementation
+//return Checksum as stored in the header (host order)
+
+uint16_t inet_checksum(const uint8_t* data, size_t length,
+                       ChecksumPath path = ChecksumPath::AUTO);
+
+//Update a checksum after one 16-bit word changed (RFC 1624 eqn. 3)
+//param checksum Current checksum
+//param old_word Word before the change
+//param new_word Word after the change
+//return New checksum
+
+uint16_t inet_checksum_adjust(uint16_t checksum, uint16_t old_word, uint16_t new_word);
+
+//Update a checksum after a field changed (RFC 1624 eqn. 3 per word)
+//The field must start at an even offset inside the checksummed data
+//param checksum Current checksum
+//param old_data Field before the change
+//param new_data Field after the change
+//param length Field length in bytes
+//return New checksum
+
+uint16_t inet_checksum_adjust(uint16_t checksum, const uint8_t* old_data,
+                              const uint8_t* new_data, size_t length);
+
+//Check whether a path can run on this CPU
+//param path Implementation
+//return true if supported
+
+bool checksum_path_available(ChecksumPath path);
+
+//Name of a path for reports
+//param path Implementation
+//return Short name ("avx2", "scalar", ...)
+
+const char* checksum_path_name(ChecksumPath path);
+
+} // namespace embedded_test
+
+#endif // INET_CHECKSUM_H
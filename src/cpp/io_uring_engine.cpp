@@ -0,0 +1,325 @@
+/**================================================================================
+* FILE: io_uring_engine.cpp
+
+* Purpose:
+* 1. Implementation of the io_uring engine (no liburing dependency)
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "io_uring_engine.h"
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace embedded_test {
+
+// user_data of linked timeouts and cancel requests; never handed back to callers
+static const uint64_t kLinkTimeoutTag = ~0ULL;
+static const uint64_t kCancelTag = ~0ULL - 1;
+
+static int uring_setup(uint32_t entries, struct io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                                    flags, nullptr, 0));
+}
+
+IoUringEngine::IoUringEngine()
+    : ring_fd_(-1),
+      sq_map_(nullptr),
+      sq_map_size_(0),
+      cq_map_(nullptr),
+      cq_map_size_(0),
+      sqes_(nullptr),
+      sqes_size_(0),
+      sq_head_(nullptr),
+      sq_tail_(nullptr),
+      sq_array_(nullptr),
+      sq_mask_(0),
+      sq_entries_(0),
+      sq_local_tail_(0),
+      sq_submitted_(0),
+      cq_head_(nullptr),
+      cq_tail_(nullptr),
+      cqes_(nullptr),
+      cq_mask_(0),
+      in_flight_(0) {
+}
+
+IoUringEngine::~IoUringEngine() {
+    close();
+}
+
+bool IoUringEngine::setup(uint32_t entries) {
+    close();
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    ring_fd_ = uring_setup(entries, &params);
+    if (ring_fd_ < 0) {
+        std::cerr << "io_uring unavailable: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+    // Kernels since 5.4 place both rings in one mapping
+    bool single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_map && cq_map_size_ > sq_map_size_) {
+        sq_map_size_ = cq_map_size_;
+    }
+
+    sq_map_ = mmap(nullptr, sq_map_size_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_map_ == MAP_FAILED) {
+        sq_map_ = nullptr;
+        close();
+        return false;
+    }
+
+    if (single_map) {
+        cq_map_ = sq_map_;
+        cq_map_size_ = 0;
+    } else {
+        cq_map_ = mmap(nullptr, cq_map_size_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_map_ == MAP_FAILED) {
+            cq_map_ = nullptr;
+            close();
+            return false;
+        }
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        sqes_size_ = 0;
+        close();
+        return false;
+    }
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+    uint8_t* sq = static_cast<uint8_t*>(sq_map_);
+    sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+    sq_submitted_ = sq_local_tail_;
+
+    uint8_t* cq = static_cast<uint8_t*>(cq_map_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+
+    timeouts_.assign(static_cast<size_t>(sq_entries_) * 2, 0);
+    in_flight_ = 0;
+
+    return true;
+}
+
+void IoUringEngine::close() {
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqes_size_);
+    }
+    if (cq_map_ != nullptr && cq_map_ != sq_map_) {
+        munmap(cq_map_, cq_map_size_);
+    }
+    if (sq_map_ != nullptr) {
+        munmap(sq_map_, sq_map_size_);
+    }
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);
+    }
+
+    ring_fd_ = -1;
+    sq_map_ = nullptr;
+    cq_map_ = nullptr;
+    sqes_ = nullptr;
+    sq_map_size_ = 0;
+    cq_map_size_ = 0;
+    sqes_size_ = 0;
+    sq_entries_ = 0;
+    in_flight_ = 0;
+}
+
+uint32_t IoUringEngine::space() const {
+    if (ring_fd_ < 0) {
+        return 0;
+    }
+    uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    return sq_entries_ - (sq_local_tail_ - head);
+}
+
+bool IoUringEngine::queue_send(int fd, const uint8_t* data, size_t len, uint64_t user_data) {
+    struct io_uring_sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->user_data = user_data;
+
+    in_flight_++;
+    return true;
+}
+
+bool IoUringEngine::queue_recv(int fd, uint8_t* buffer, size_t len, uint64_t user_data,
+                               uint32_t timeout_ms) {
+    if (space() < (timeout_ms > 0 ? 2u : 1u)) {
+        return false;
+    }
+
+    struct io_uring_sqe* sqe = next_sqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->user_data = user_data;
+    in_flight_++;
+
+    link_timeout(sqe, timeout_ms);
+    return true;
+}
+
+bool IoUringEngine::queue_recvmsg(int fd, struct msghdr* msg, uint64_t user_data,
+                                  uint32_t timeout_ms) {
+    if (space() < (timeout_ms > 0 ? 2u : 1u)) {
+        return false;
+    }
+
+    struct io_uring_sqe* sqe = next_sqe();
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(msg);
+    sqe->len = 1;
+    sqe->user_data = user_data;
+    in_flight_++;
+
+    link_timeout(sqe, timeout_ms);
+    return true;
+}
+
+bool IoUringEngine::queue_cancel(uint64_t user_data) {
+    struct io_uring_sqe* sqe = next_sqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = user_data;
+    sqe->user_data = kCancelTag;
+    return true;
+}
+
+int IoUringEngine::submit(uint32_t wait_for) {
+    if (ring_fd_ < 0) {
+        return -1;
+    }
+
+    uint32_t to_submit = sq_local_tail_ - sq_submitted_;
+    __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+
+    if (to_submit == 0 && wait_for == 0) {
+        return 0;
+    }
+
+    uint32_t flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+    int submitted;
+    do {
+        submitted = uring_enter(ring_fd_, to_submit, wait_for, flags);
+    } while (submitted < 0 && errno == EINTR);
+
+    if (submitted < 0) {
+        return -1;
+    }
+
+    sq_submitted_ += static_cast<uint32_t>(submitted);
+    return submitted;
+}
+
+size_t IoUringEngine::reap(std::vector<IoCompletion>& out, size_t max) {
+    if (ring_fd_ < 0) {
+        return 0;
+    }
+
+    uint32_t head = *cq_head_;
+    uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    size_t reaped = 0;
+
+    while (head != tail && reaped < max) {
+        const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+        head++;
+
+        if (cqe.user_data == kLinkTimeoutTag || cqe.user_data == kCancelTag) {
+            continue;
+        }
+
+        IoCompletion completion;
+        completion.user_data = cqe.user_data;
+        completion.result = cqe.res;
+        out.push_back(completion);
+        reaped++;
+        in_flight_--;
+    }
+
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+// Private helper methods
+
+struct io_uring_sqe* IoUringEngine::next_sqe() {
+    if (space() == 0) {
+        return nullptr;
+    }
+
+    uint32_t index = sq_local_tail_ & sq_mask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    sq_local_tail_++;
+
+    return sqe;
+}
+
+void IoUringEngine::link_timeout(struct io_uring_sqe* sqe, uint32_t timeout_ms) {
+    if (timeout_ms == 0) {
+        return;
+    }
+
+    // The timeout only cancels the operation it is linked to
+    sqe->flags |= IOSQE_IO_LINK;
+
+    uint32_t slot = sq_local_tail_ & sq_mask_;
+    struct io_uring_sqe* timeout = next_sqe();
+    int64_t* ts = &timeouts_[static_cast<size_t>(slot) * 2];
+    ts[0] = timeout_ms / 1000;
+    ts[1] = static_cast<int64_t>(timeout_ms % 1000) * 1000000;
+
+    timeout->opcode = IORING_OP_LINK_TIMEOUT;
+    timeout->fd = -1;
+    timeout->addr = reinterpret_cast<uint64_t>(ts);
+    timeout->len = 1;
+    timeout->user_data = kLinkTimeoutTag;
+}
+
+} // namespace embedded_test
@@ -0,0 +1,160 @@
+/**================================================================================
+* FILE: io_uring_engine.h
+
+* Purpose:
+* 1. Minimal io_uring submission/completion engine built on raw syscalls
+* 2. Lets one thread keep many socket sends and receives in flight
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef IO_URING_ENGINE_H
+#define IO_URING_ENGINE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct msghdr;
+
+namespace embedded_test {
+
+//One reaped completion
+//result is the syscall return value, or -errno on failure
+//(-ECANCELED for a receive whose linked timeout fired)
+
+struct IoCompletion {
+    uint64_t user_data;
+    int32_t result;
+
+    IoCompletion() : user_data(0), result(0) {}
+};
+
+//io_uring instance
+//Operations are queued as submission entries and only handed to the
+//kernel by submit(), so a whole batch costs one io_uring_enter() call
+
+class IoUringEngine {
+public:
+    IoUringEngine();
+    ~IoUringEngine();
+
+    IoUringEngine(const IoUringEngine&) = delete;
+    IoUringEngine& operator=(const IoUringEngine&) = delete;
+
+    //Create the rings
+    //param entries Submission queue depth (rounded up to a power of two)
+    //return true if successful
+
+    bool setup(uint32_t entries);
+
+    //Tear down the rings (in-flight operations are cancelled by the kernel)
+
+    void close();
+
+    bool is_open() const { return ring_fd_ >= 0; }
+
+    //Free submission slots
+
+    uint32_t space() const;
+
+    //Queue a send on a socket
+    //param fd Socket descriptor
+    //param data Frame data (must stay valid until its completion is reaped)
+    //param len Frame length
+    //param user_data Returned with the completion
+    //return false if the submission queue is full
+
+    bool queue_send(int fd, const uint8_t* data, size_t len, uint64_t user_data);
+
+    //Queue a receive on a socket, optionally bounded by a linked timeout
+    //Uses two submission slots when timeout_ms is non-zero
+    //param fd Socket descriptor
+    //param buffer Receive buffer (must stay valid until its completion is reaped)
+    //param len Buffer size
+    //param user_data Returned with the completion
+    //param timeout_ms Cancel the receive after this long, 0 for no timeout
+    //return false if the submission queue is full
+
+    bool queue_recv(int fd, uint8_t* buffer, size_t len, uint64_t user_data,
+                    uint32_t timeout_ms);
+
+    //Queue a recvmsg on a socket, optionally bounded by a linked timeout
+    //Same as queue_recv, but the source address (e.g. sockaddr_ll and its
+    //packet type) comes back in msg->msg_name
+    //param fd Socket descriptor
+    //param msg Message header (it and its buffers must stay valid until
+    //its completion is reaped)
+    //param user_data Returned with the completion
+    //param timeout_ms Cancel the receive after this long, 0 for no timeout
+    //return false if the submission queue is full
+
+    bool queue_recvmsg(int fd, struct msghdr* msg, uint64_t user_data, uint32_t timeout_ms);
+
+    //Ask the kernel to cancel an operation still in flight
+    //The operation completes with -ECANCELED (or normally if it already
+    //finished); the cancel request itself produces no completion
+    //param user_data user_data the operation was queued with
+    //return false if the submission queue is full
+
+    bool queue_cancel(uint64_t user_data);
+
+    //Hand queued entries to the kernel
+    //param wait_for Block until at least this many completions are ready
+    //return Number of entries submitted, -1 on error
+
+    int submit(uint32_t wait_for = 0);
+
+    //Collect ready completions without blocking
+    //Linked-timeout completions are consumed internally and not returned
+    //param out Completions are appended here
+    //param max Maximum number to collect
+    //return Number of completions appended
+
+    size_t reap(std::vector<IoCompletion>& out, size_t max);
+
+    //Operations queued whose completions have not been reaped yet
+
+    uint32_t in_flight() const { return in_flight_; }
+
+private:
+    int ring_fd_;
+
+    void* sq_map_;
+    size_t sq_map_size_;
+    void* cq_map_;
+    size_t cq_map_size_;
+    struct io_uring_sqe* sqes_;
+    size_t sqes_size_;
+
+    uint32_t* sq_head_;
+    uint32_t* sq_tail_;
+    uint32_t* sq_array_;
+    uint32_t sq_mask_;
+    uint32_t sq_entries_;
+    uint32_t sq_local_tail_;
+    uint32_t sq_submitted_;
+
+    uint32_t* cq_head_;
+    uint32_t* cq_tail_;
+    struct io_uring_cqe* cqes_;
+    uint32_t cq_mask_;
+
+    uint32_t in_flight_;
+
+    // Linked-timeout values, one per submission slot; the kernel reads them
+    // during submit
+    std::vector<int64_t> timeouts_;
+
+    // Helper methods
+    struct io_uring_sqe* next_sqe();
+    void link_timeout(struct io_uring_sqe* sqe, uint32_t timeout_ms);
+};
+
+} // namespace embedded_test
+
+#endif // IO_URING_ENGINE_H
@@ -0,0 +1,226 @@
+/**================================================================================
+* FILE: latency_histogram.cpp
+
+* Purpose:
+* 1. Implementation of the HDR-layout latency histograms
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace embedded_test {
+
+static const uint64_t kNoMinimum = std::numeric_limits<uint64_t>::max();
+
+HistogramLayout::HistogramLayout(const HistogramConfig& requested) : config(requested) {
+    config.significant_digits = std::min(5, std::max(1, config.significant_digits));
+    config.lowest_ns = std::max<uint64_t>(1, config.lowest_ns);
+    config.highest_ns = std::max(config.highest_ns, config.lowest_ns * 2);
+
+    unit_magnitude = 63 - __builtin_clzll(config.lowest_ns);
+
+    // Enough linear sub-buckets to tell 2 * 10^digits values apart
+    uint64_t single_unit_range = 2;
+    for (int i = 0; i < config.significant_digits; i++) {
+        single_unit_range *= 10;
+    }
+    int sub_bucket_count_magnitude = 64 - __builtin_clzll(single_unit_range - 1);
+    sub_bucket_half_count_magnitude = sub_bucket_count_magnitude - 1;
+    sub_bucket_half_count = 1ULL << sub_bucket_half_count_magnitude;
+
+    uint64_t sub_bucket_count = 1ULL << sub_bucket_count_magnitude;
+    sub_bucket_mask = (sub_bucket_count - 1) << unit_magnitude;
+
+    // Double the covered range until highest_ns fits
+    uint64_t smallest_untrackable = sub_bucket_count << unit_magnitude;
+    size_t buckets = 1;
+    while (smallest_untrackable <= config.highest_ns) {
+        if (smallest_untrackable > (kNoMinimum >> 1)) {
+            buckets++;
+            break;
+        }
+        smallest_untrackable <<= 1;
+        buckets++;
+    }
+    counts_length = (buckets + 1) * sub_bucket_half_count;
+}
+
+uint64_t HistogramLayout::lowest_equivalent(size_t index) const {
+    int bucket = static_cast<int>(index >> sub_bucket_half_count_magnitude) - 1;
+    uint64_t sub_bucket = (index & (sub_bucket_half_count - 1)) + sub_bucket_half_count;
+    if (bucket < 0) {
+        sub_bucket -= sub_bucket_half_count;
+        bucket = 0;
+    }
+    return sub_bucket << (bucket + unit_magnitude);
+}
+
+uint64_t HistogramLayout::highest_equivalent(size_t index) const {
+    int bucket = std::max(0, static_cast<int>(index >> sub_bucket_half_count_magnitude) - 1);
+    return lowest_equivalent(index) + (1ULL << (bucket + unit_magnitude)) - 1;
+}
+
+uint64_t HistogramLayout::median_equivalent(size_t index) const {
+    int bucket = std::max(0, static_cast<int>(index >> sub_bucket_half_count_magnitude) - 1);
+    return lowest_equivalent(index) + ((1ULL << (bucket + unit_magnitude)) >> 1);
+}
+
+bool HistogramLayout::same_as(const HistogramLayout& other) const {
+    return unit_magnitude == other.unit_magnitude &&
+           sub_bucket_half_count_magnitude == other.sub_bucket_half_count_magnitude &&
+           counts_length == other.counts_length &&
+           config.highest_ns == other.config.highest_ns;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : total_(0), sum_(0), min_(kNoMinimum), max_(0) {
+}
+
+LatencyHistogram::LatencyHistogram(const HistogramConfig& config)
+    : layout_(config),
+      counts_(layout_.counts_length, 0),
+      total_(0), sum_(0), min_(kNoMinimum), max_(0) {
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+    record_n(value_ns, 1);
+}
+
+void LatencyHistogram::add(const LatencyHistogram& other) {
+    if (other.total_ == 0) {
+        return;
+    }
+
+    if (counts_.empty()) {
+        *this = other;
+        return;
+    }
+
+    if (layout_.same_as(other.layout_)) {
+        for (size_t i = 0; i < counts_.size(); i++) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+    } else {
+        for (size_t i = 0; i < other.counts_.size(); i++) {
+            if (other.counts_[i] != 0) {
+                counts_[layout_.index_of(other.layout_.median_equivalent(i))] += other.counts_[i];
+            }
+        }
+        total_ += other.total_;
+    }
+
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_ = 0;
+    sum_ = 0;
+    min_ = kNoMinimum;
+    max_ = 0;
+}
+
+double LatencyHistogram::mean() const {
+    return total_ ? static_cast<double>(sum_) / total_ : 0.0;
+}
+
+double LatencyHistogram::stddev() const {
+    if (total_ == 0) {
+        return 0.0;
+    }
+
+    double average = mean();
+    double squares = 0.0;
+    for (size_t i = 0; i < counts_.size(); i++) {
+        if (counts_[i] != 0) {
+            double deviation = static_cast<double>(layout_.median_equivalent(i)) - average;
+            squares += deviation * deviation * counts_[i];
+        }
+    }
+    return std::sqrt(squares / total_);
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (total_ == 0) {
+        return 0;
+    }
+
+    percent = std::min(100.0, std::max(0.0, percent));
+    uint64_t target = static_cast<uint64_t>(std::ceil(percent / 100.0 * total_));
+    target = std::max<uint64_t>(1, target);
+
+    uint64_t running = 0;
+    for (size_t i = 0; i < counts_.size(); i++) {
+        running += counts_[i];
+        if (running >= target) {
+            // Report the bucket's top, but never outside what was recorded
+            uint64_t value = layout_.highest_equivalent(i);
+            return std::max(min_, std::min(value, max_));
+        }
+    }
+    return max_;
+}
+
+// Private helper methods
+
+void LatencyHistogram::record_n(uint64_t value_ns, uint64_t count) {
+    if (counts_.empty()) {
+        layout_ = HistogramLayout(HistogramConfig());
+        counts_.assign(layout_.counts_length, 0);
+    }
+
+    counts_[layout_.index_of(value_ns)] += count;
+    total_ += count;
+    sum_ += value_ns * count;
+    min_ = std::min(min_, value_ns);
+    max_ = std::max(max_, value_ns);
+}
+
+AtomicLatencyHistogram::AtomicLatencyHistogram(const HistogramConfig& config)
+    : total_(0), sum_(0), min_(kNoMinimum), max_(0) {
+    configure(config);
+}
+
+void AtomicLatencyHistogram::configure(const HistogramConfig& config) {
+    layout_ = HistogramLayout(config);
+    counts_.reset(new std::atomic<uint64_t>[layout_.counts_length]);
+    reset();
+}
+
+void AtomicLatencyHistogram::reset() {
+    for (size_t i = 0; i < layout_.counts_length; i++) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+    total_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(kNoMinimum, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+void AtomicLatencyHistogram::snapshot_into(LatencyHistogram& out) const {
+    LatencyHistogram snapshot(layout_.config);
+
+    // Total comes from the buckets so percentiles stay consistent with
+    // them even while other threads keep recording
+    for (size_t i = 0; i < layout_.counts_length; i++) {
+        uint64_t count = counts_[i].load(std::memory_order_relaxed);
+        snapshot.counts_[i] = count;
+        snapshot.total_ += count;
+    }
+    snapshot.sum_ = sum_.load(std::memory_order_relaxed);
+    snapshot.min_ = min_.load(std::memory_order_relaxed);
+    snapshot.max_ = max_.load(std::memory_order_relaxed);
+
+    out.add(snapshot);
+}
+
+} // namespace embedded_test
@@ -0,0 +1,167 @@
+/**================================================================================
+* FILE: latency_histogram.h
+
+* Purpose:
+* 1. Fixed-memory latency histogram (HDR layout) with percentiles
+* 2. Lock-free variant recorded on the send/receive hot path
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace embedded_test {
+
+//Range and precision of a histogram
+
+struct HistogramConfig {
+    uint64_t lowest_ns;         // smallest value told apart from 0
+    uint64_t highest_ns;        // larger values are counted as this
+    int significant_digits;     // 1..5; 2 keeps every value within 1%
+
+    HistogramConfig() : lowest_ns(1), highest_ns(60000000000ULL), significant_digits(2) {}
+};
+
+//Bucket layout shared by both histogram types
+//Values are grouped in power-of-two buckets, each split into enough
+//linear sub-buckets to hold the requested number of significant digits,
+//so memory depends on the range's magnitude, not on its size
+
+struct HistogramLayout {
+    HistogramConfig config;
+    int unit_magnitude;
+    int sub_bucket_half_count_magnitude;
+    uint64_t sub_bucket_half_count;
+    uint64_t sub_bucket_mask;
+    size_t counts_length;
+
+    HistogramLayout() : unit_magnitude(0), sub_bucket_half_count_magnitude(0),
+                        sub_bucket_half_count(0), sub_bucket_mask(0), counts_length(0) {}
+    explicit HistogramLayout(const HistogramConfig& config);
+
+    size_t index_of(uint64_t value) const {
+        if (value > config.highest_ns) {
+            value = config.highest_ns;
+        }
+        int pow2_ceiling = 64 - __builtin_clzll(value | sub_bucket_mask);
+        int bucket = pow2_ceiling - unit_magnitude - (sub_bucket_half_count_magnitude + 1);
+        uint64_t sub_bucket = value >> (bucket + unit_magnitude);
+        return (static_cast<size_t>(bucket + 1) << sub_bucket_half_count_magnitude) +
+               (sub_bucket - sub_bucket_half_count);
+    }
+
+    uint64_t lowest_equivalent(size_t index) const;
+    uint64_t highest_equivalent(size_t index) const;
+    uint64_t median_equivalent(size_t index) const;
+    bool same_as(const HistogramLayout& other) const;
+};
+
+//Latency histogram (values in nanoseconds)
+//A default-constructed histogram holds no storage and takes the layout of
+//the first histogram added to it, so empty PacketStats stay cheap to copy
+
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+    explicit LatencyHistogram(const HistogramConfig& config);
+
+    //Count one value
+    //param value_ns Value in nanoseconds (clamped to the configured range)
+
+    void record(uint64_t value_ns);
+
+    //Add another histogram's counts
+    //Buckets are re-binned if the two layouts differ
+    //param other Histogram to merge
+
+    void add(const LatencyHistogram& other);
+
+    void reset();
+
+    uint64_t count() const { return total_; }
+    uint64_t min() const { return total_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const;
+    double stddev() const;
+
+    //Value at or below which percent of the recorded values fall
+    //param percent 0..100 (e.g. 99.9)
+    //return Value in nanoseconds, 0 if empty
+
+    uint64_t percentile(double percent) const;
+
+    const HistogramConfig& config() const { return layout_.config; }
+
+    //Bytes of bucket storage
+
+    size_t memory_size() const { return counts_.size() * sizeof(uint64_t); }
+
+private:
+    friend class AtomicLatencyHistogram;
+
+    HistogramLayout layout_;
+    std::vector<uint64_t> counts_;
+    uint64_t total_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+
+    void record_n(uint64_t value_ns, uint64_t count);
+};
+
+//Histogram that several threads may record into at once
+//Storage is allocated by configure(); record() only does relaxed atomic
+//adds, so it never allocates or locks
+
+class AtomicLatencyHistogram {
+public:
+    explicit AtomicLatencyHistogram(const HistogramConfig& config = HistogramConfig());
+
+    //Replace the layout and clear the counts (not concurrently with record)
+    //param config Range and precision
+
+    void configure(const HistogramConfig& config);
+
+    void record(uint64_t value_ns) {
+        counts_[layout_.index_of(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value_ns, std::memory_order_relaxed);
+
+        uint64_t seen = min_.load(std::memory_order_relaxed);
+        while (value_ns < seen && !min_.compare_exchange_weak(seen, value_ns, std::memory_order_relaxed)) {
+        }
+        seen = max_.load(std::memory_order_relaxed);
+        while (value_ns > seen && !max_.compare_exchange_weak(seen, value_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset();
+
+    //Add the current counts to out
+    //param out Histogram to merge into (takes this layout if empty)
+
+    void snapshot_into(LatencyHistogram& out) const;
+
+    const HistogramConfig& config() const { return layout_.config; }
+
+private:
+    HistogramLayout layout_;
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+    std::atomic<uint64_t> total_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace embedded_test
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,706 @@
+/**================================================================================
+* FILE: packet_filter.cpp
+
+* Purpose:
+* 1. Parser for filter expressions
+* 2. Code generation to classic BPF (expression -> OR of AND clauses -> jumps)
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "packet_filter.h"
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+namespace embedded_test {
+
+namespace {
+
+// Frame layout offsets (untagged Ethernet II, IPv4)
+const uint32_t kEtherDst = 0;
+const uint32_t kEtherSrc = 6;
+const uint32_t kEtherType = 12;
+const uint32_t kIpHeader = 14;
+const uint32_t kIpFragment = 20;
+const uint32_t kIpProto = 23;
+const uint32_t kIpSrc = 26;
+const uint32_t kIpDst = 30;
+
+const uint32_t kEtherTypeIp = 0x0800;
+const uint32_t kEtherTypeArp = 0x0806;
+const uint32_t kEtherTypeIp6 = 0x86DD;
+const uint32_t kProtoIcmp = 1;
+const uint32_t kProtoTcp = 6;
+const uint32_t kProtoUdp = 17;
+
+// Snap length returned for accepted frames (whole frame)
+const uint32_t kAcceptLength = 0x40000;
+
+// Upper bound on AND clauses after expansion; keeps programs small
+const size_t kMaxClauses = 64;
+
+// One load compared against a set of values; matches if any value is equal
+struct Atom {
+    bool indirect;          // offset is relative to the IP header (X = IHL * 4)
+    uint16_t size;          // BPF_B, BPF_H or BPF_W
+    uint32_t offset;
+    bool has_mask;
+    uint32_t mask;          // ANDed in before the compare when has_mask (0 is a valid mask)
+    std::vector<uint32_t> values;
+};
+
+// All atoms must match
+typedef std::vector<Atom> Test;
+
+struct Node {
+    enum Kind { TEST, AND, OR, NOT };
+
+    Kind kind;
+    Test test;
+    std::unique_ptr<Node> left;
+    std::unique_ptr<Node> right;
+
+    explicit Node(Kind k) : kind(k) {}
+};
+
+typedef std::unique_ptr<Node> NodePtr;
+
+struct Literal {
+    const Test* test;
+    bool negated;
+};
+
+typedef std::vector<Literal> Clause;
+
+Atom make_atom(uint16_t size, uint32_t offset, uint32_t value) {
+    Atom atom;
+    atom.indirect = false;
+    atom.size = size;
+    atom.offset = offset;
+    atom.has_mask = false;
+    atom.mask = 0;
+    atom.values.push_back(value);
+    return atom;
+}
+
+Atom make_masked_atom(uint16_t size, uint32_t offset, uint32_t value, uint32_t mask) {
+    Atom atom = make_atom(size, offset, value);
+    atom.has_mask = true;
+    atom.mask = mask;
+    return atom;
+}
+
+NodePtr make_test(const Test& test) {
+    NodePtr node(new Node(Node::TEST));
+    node->test = test;
+    return node;
+}
+
+NodePtr make_binary(Node::Kind kind, NodePtr left, NodePtr right) {
+    NodePtr node(new Node(kind));
+    node->left = std::move(left);
+    node->right = std::move(right);
+    return node;
+}
+
+NodePtr make_not(NodePtr child) {
+    NodePtr node(new Node(Node::NOT));
+    node->left = std::move(child);
+    return node;
+}
+
+// Recursive-descent parser over a token list
+class Parser {
+public:
+    explicit Parser(const std::string& text) : pos_(0) { tokenize(text); }
+
+    NodePtr parse() {
+        NodePtr root = parse_or();
+        if (root && pos_ < tokens_.size()) {
+            fail("unexpected '" + tokens_[pos_] + "'");
+            return NodePtr();
+        }
+        return root;
+    }
+
+    bool empty() const { return tokens_.empty(); }
+    const std::string& error() const { return error_; }
+
+private:
+    std::vector<std::string> tokens_;
+    size_t pos_;
+    std::string error_;
+
+    void tokenize(const std::string& text) {
+        size_t i = 0;
+        while (i < text.size()) {
+            char c = text[i];
+            if (isspace(static_cast<unsigned char>(c))) {
+                i++;
+            } else if (isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                size_t start = i;
+                while (i < text.size() &&
+                       (isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_' ||
+                        text[i] == ':' || text[i] == '.')) {
+                    i++;
+                }
+                tokens_.push_back(text.substr(start, i - start));
+            } else if (i + 1 < text.size() &&
+                       (text.compare(i, 2, "&&") == 0 || text.compare(i, 2, "||") == 0 ||
+                        text.compare(i, 2, "==") == 0 || text.compare(i, 2, "!=") == 0)) {
+                tokens_.push_back(text.substr(i, 2));
+                i += 2;
+            } else {
+                tokens_.push_back(std::string(1, c));
+                i++;
+            }
+        }
+    }
+
+    void fail(const std::string& message) {
+        if (error_.empty()) {
+            error_ = message;
+        }
+    }
+
+    bool at(const char* token) const {
+        return pos_ < tokens_.size() && tokens_[pos_] == token;
+    }
+
+    bool accept(const char* token) {
+        if (at(token)) {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool expect(const char* token) {
+        if (accept(token)) {
+            return true;
+        }
+        fail(std::string("expected '") + token + "'" +
+             (pos_ < tokens_.size() ? " before '" + tokens_[pos_] + "'" : " at end"));
+        return false;
+    }
+
+    bool next_word(std::string& word, const char* what) {
+        if (pos_ >= tokens_.size()) {
+            fail(std::string("expected ") + what + " at end");
+            return false;
+        }
+        word = tokens_[pos_++];
+        return true;
+    }
+
+    bool number(uint32_t& value, const char* what) {
+        std::string word;
+        if (!next_word(word, what)) {
+            return false;
+        }
+
+        char* end = nullptr;
+        errno = 0;
+        unsigned long parsed = strtoul(word.c_str(), &end, 0);
+        if (word.empty() || *end != '\0' || errno != 0 || parsed > 0xFFFFFFFFUL ||
+            !isdigit(static_cast<unsigned char>(word[0]))) {
+            fail("bad " + std::string(what) + " '" + word + "'");
+            return false;
+        }
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    }
+
+    bool mac(uint8_t out[6]) {
+        std::string word;
+        if (!next_word(word, "MAC address")) {
+            return false;
+        }
+
+        unsigned int parts[6];
+        char tail;
+        if (sscanf(word.c_str(), "%2x:%2x:%2x:%2x:%2x:%2x%c", &parts[0], &parts[1], &parts[2],
+                   &parts[3], &parts[4], &parts[5], &tail) != 6) {
+            fail("bad MAC address '" + word + "'");
+            return false;
+        }
+        for (int i = 0; i < 6; i++) {
+            out[i] = static_cast<uint8_t>(parts[i]);
+        }
+        return true;
+    }
+
+    bool ipv4(uint32_t& address) {
+        std::string word;
+        if (!next_word(word, "IPv4 address")) {
+            return false;
+        }
+
+        struct in_addr parsed;
+        if (inet_pton(AF_INET, word.c_str(), &parsed) != 1) {
+            fail("bad IPv4 address '" + word + "'");
+            return false;
+        }
+        address = ntohl(parsed.s_addr);
+        return true;
+    }
+
+    NodePtr parse_or() {
+        NodePtr left = parse_and();
+        while (left && (accept("or") || accept("||"))) {
+            NodePtr right = parse_and();
+            if (!right) {
+                return NodePtr();
+            }
+            left = make_binary(Node::OR, std::move(left), std::move(right));
+        }
+        return left;
+    }
+
+    NodePtr parse_and() {
+        NodePtr left = parse_unary();
+        while (left && (accept("and") || accept("&&"))) {
+            NodePtr right = parse_unary();
+            if (!right) {
+                return NodePtr();
+            }
+            left = make_binary(Node::AND, std::move(left), std::move(right));
+        }
+        return left;
+    }
+
+    NodePtr parse_unary() {
+        if (accept("not") || accept("!")) {
+            NodePtr child = parse_unary();
+            return child ? make_not(std::move(child)) : NodePtr();
+        }
+        if (accept("(")) {
+            NodePtr inner = parse_or();
+            if (!inner || !expect(")")) {
+                return NodePtr();
+            }
+            return inner;
+        }
+        return parse_primitive();
+    }
+
+    NodePtr parse_primitive() {
+        std::string word;
+        if (!next_word(word, "a filter term")) {
+            return NodePtr();
+        }
+
+        if (word == "ether") {
+            return parse_ether();
+        }
+        if (word == "ip") {
+            return parse_ip();
+        }
+        if (word == "ip6") {
+            return make_test(Test{make_atom(BPF_H, kEtherType, kEtherTypeIp6)});
+        }
+        if (word == "arp") {
+            return make_test(Test{make_atom(BPF_H, kEtherType, kEtherTypeArp)});
+        }
+        if (word == "icmp") {
+            return make_test(ip_proto({kProtoIcmp}));
+        }
+        if (word == "udp" || word == "tcp") {
+            uint32_t proto = (word == "udp") ? kProtoUdp : kProtoTcp;
+            if (at("src") || at("dst") || at("port")) {
+                return parse_port({proto});
+            }
+            return make_test(ip_proto({proto}));
+        }
+        if (word == "port") {
+            pos_--;
+            return parse_port({kProtoUdp, kProtoTcp});
+        }
+        if (word == "byte" || word == "half" || word == "word") {
+            uint16_t size = (word == "byte") ? BPF_B : (word == "half") ? BPF_H : BPF_W;
+            return parse_compare(size);
+        }
+
+        fail("unknown term '" + word + "'");
+        return NodePtr();
+    }
+
+    NodePtr parse_ether() {
+        std::string field;
+        if (!next_word(field, "ether field")) {
+            return NodePtr();
+        }
+
+        if (field == "type" || field == "proto") {
+            uint32_t type;
+            if (!number(type, "ether type")) {
+                return NodePtr();
+            }
+            return make_test(Test{make_atom(BPF_H, kEtherType, type)});
+        }
+
+        if (field != "src" && field != "dst" && field != "host") {
+            fail("unknown ether field '" + field + "'");
+            return NodePtr();
+        }
+
+        uint8_t address[6];
+        if (!mac(address)) {
+            return NodePtr();
+        }
+        uint32_t high = (static_cast<uint32_t>(address[0]) << 24) | (address[1] << 16) |
+                        (address[2] << 8) | address[3];
+        uint32_t low = (static_cast<uint32_t>(address[4]) << 8) | address[5];
+
+        auto at_offset = [&](uint32_t offset) {
+            return make_test(Test{make_atom(BPF_W, offset, high), make_atom(BPF_H, offset + 4, low)});
+        };
+
+        if (field == "src") {
+            return at_offset(kEtherSrc);
+        }
+        if (field == "dst") {
+            return at_offset(kEtherDst);
+        }
+        return make_binary(Node::OR, at_offset(kEtherSrc), at_offset(kEtherDst));
+    }
+
+    NodePtr parse_ip() {
+        if (accept("proto")) {
+            uint32_t proto;
+            if (!number(proto, "IP protocol")) {
+                return NodePtr();
+            }
+            return make_test(ip_proto({proto}));
+        }
+
+        bool src = at("src");
+        bool dst = at("dst");
+        bool host = at("host");
+        if (!src && !dst && !host) {
+            return make_test(Test{make_atom(BPF_H, kEtherType, kEtherTypeIp)});
+        }
+        pos_++;
+
+        uint32_t address;
+        if (!ipv4(address)) {
+            return NodePtr();
+        }
+
+        auto at_offset = [&](uint32_t offset) {
+            return make_test(Test{make_atom(BPF_H, kEtherType, kEtherTypeIp),
+                                  make_atom(BPF_W, offset, address)});
+        };
+
+        if (src) {
+            return at_offset(kIpSrc);
+        }
+        if (dst) {
+            return at_offset(kIpDst);
+        }
+        return make_binary(Node::OR, at_offset(kIpSrc), at_offset(kIpDst));
+    }
+
+    // [src|dst] port N, for the given IP protocols
+    NodePtr parse_port(const std::vector<uint32_t>& protos) {
+        bool src = accept("src");
+        bool dst = !src && accept("dst");
+        if (!expect("port")) {
+            return NodePtr();
+        }
+
+        uint32_t port;
+        if (!number(port, "port")) {
+            return NodePtr();
+        }
+        if (port > 0xFFFF) {
+            fail("port out of range");
+            return NodePtr();
+        }
+
+        auto at_offset = [&](uint32_t offset) {
+            Test test = ip_proto(protos);
+            // Only the first fragment carries the transport header
+            test.push_back(make_masked_atom(BPF_H, kIpFragment, 0, 0x1FFF));
+            Atom atom = make_atom(BPF_H, kIpHeader + offset, port);
+            atom.indirect = true;
+            test.push_back(atom);
+            return make_test(test);
+        };
+
+        if (src) {
+            return at_offset(0);
+        }
+        if (dst) {
+            return at_offset(2);
+        }
+        return make_binary(Node::OR, at_offset(0), at_offset(2));
+    }
+
+    // byte|half|word [offset] [& mask] ==|!= value
+    NodePtr parse_compare(uint16_t size) {
+        uint32_t offset;
+        if (!expect("[") || !number(offset, "offset") || !expect("]")) {
+            return NodePtr();
+        }
+
+        uint32_t mask = 0;
+        bool has_mask = accept("&");
+        if (has_mask && !number(mask, "mask")) {
+            return NodePtr();
+        }
+
+        bool negate = false;
+        if (accept("!=")) {
+            negate = true;
+        } else if (!accept("==") && !expect("=")) {
+            return NodePtr();
+        }
+
+        uint32_t value;
+        if (!number(value, "value")) {
+            return NodePtr();
+        }
+
+        Atom atom = has_mask ? make_masked_atom(size, offset, value, mask)
+                             : make_atom(size, offset, value);
+        NodePtr test = make_test(Test{atom});
+        if (negate) {
+            return make_not(std::move(test));
+        }
+        return test;
+    }
+
+    static Test ip_proto(const std::vector<uint32_t>& protos) {
+        Atom proto = make_atom(BPF_B, kIpProto, 0);
+        proto.values = protos;
+        return Test{make_atom(BPF_H, kEtherType, kEtherTypeIp), proto};
+    }
+};
+
+// Rewrite the tree as an OR of AND clauses, pushing NOTs down to the tests
+bool to_clauses(const Node& node, bool negated, std::vector<Clause>& out) {
+    switch (node.kind) {
+    case Node::TEST:
+        out.push_back(Clause{Literal{&node.test, negated}});
+        return true;
+
+    case Node::NOT:
+        return to_clauses(*node.left, !negated, out);
+
+    default:
+        break;
+    }
+
+    std::vector<Clause> left;
+    std::vector<Clause> right;
+    if (!to_clauses(*node.left, negated, left) || !to_clauses(*node.right, negated, right)) {
+        return false;
+    }
+
+    // De Morgan: a negated AND behaves as an OR and vice versa
+    bool is_or = (node.kind == Node::OR) != negated;
+    if (is_or) {
+        out.insert(out.end(), left.begin(), left.end());
+        out.insert(out.end(), right.begin(), right.end());
+    } else {
+        if (left.size() * right.size() > kMaxClauses) {
+            return false;
+        }
+        for (const Clause& a : left) {
+            for (const Clause& b : right) {
+                Clause merged = a;
+                merged.insert(merged.end(), b.begin(), b.end());
+                out.push_back(merged);
+            }
+        }
+    }
+
+    return out.size() <= kMaxClauses;
+}
+
+// Instruction stream with forward labels resolved at the end
+class Emitter {
+public:
+    int new_label() {
+        labels_.push_back(-1);
+        return static_cast<int>(labels_.size()) - 1;
+    }
+
+    void bind(int label) { labels_[label] = static_cast<int>(code_.size()); }
+
+    void op(uint16_t code, uint32_t k) {
+        code_.push_back(BPF_STMT(code, k));
+    }
+
+    // jt/jf are labels, or kNext to fall through
+    void jump_eq(uint32_t k, int jt, int jf) {
+        int index = static_cast<int>(code_.size());
+        code_.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, k, 0, 0));
+        if (jt != kNext) {
+            fixups_.push_back(Fixup{index, true, jt});
+        }
+        if (jf != kNext) {
+            fixups_.push_back(Fixup{index, false, jf});
+        }
+    }
+
+    bool finish(std::vector<struct sock_filter>& program, std::string& error) {
+        for (const Fixup& fixup : fixups_) {
+            int distance = labels_[fixup.label] - (fixup.index + 1);
+            if (distance < 0 || distance > 255) {
+                error = "expression too long (jump out of range)";
+                return false;
+            }
+            if (fixup.true_branch) {
+                code_[fixup.index].jt = static_cast<uint8_t>(distance);
+            } else {
+                code_[fixup.index].jf = static_cast<uint8_t>(distance);
+            }
+        }
+        if (code_.size() > BPF_MAXINSNS) {
+            error = "expression too long";
+            return false;
+        }
+        program.swap(code_);
+        return true;
+    }
+
+    static const int kNext = -1;
+
+private:
+    struct Fixup {
+        int index;
+        bool true_branch;
+        int label;
+    };
+
+    std::vector<struct sock_filter> code_;
+    std::vector<int> labels_;
+    std::vector<Fixup> fixups_;
+};
+
+// Load the atom's field and branch to on_match / on_miss
+void emit_atom(Emitter& out, const Atom& atom, int on_match, int on_miss) {
+    if (atom.indirect) {
+        out.op(BPF_LDX | BPF_B | BPF_MSH, kIpHeader);
+        out.op(BPF_LD | atom.size | BPF_IND, atom.offset);
+    } else {
+        out.op(BPF_LD | atom.size | BPF_ABS, atom.offset);
+    }
+    if (atom.has_mask) {
+        out.op(BPF_ALU | BPF_AND | BPF_K, atom.mask);
+    }
+
+    // Any value matches; only the last compare can miss
+    int done = (on_match == Emitter::kNext) ? out.new_label() : on_match;
+    for (size_t i = 0; i < atom.values.size(); i++) {
+        bool last = (i + 1 == atom.values.size());
+        out.jump_eq(atom.values[i], last ? on_match : done, last ? on_miss : Emitter::kNext);
+    }
+    if (on_match == Emitter::kNext) {
+        out.bind(done);
+    }
+}
+
+void emit_literal(Emitter& out, const Literal& literal, int clause_fail) {
+    const Test& test = *literal.test;
+
+    if (!literal.negated) {
+        for (const Atom& atom : test) {
+            emit_atom(out, atom, Emitter::kNext, clause_fail);
+        }
+        return;
+    }
+
+    // NOT(a AND b): any miss satisfies the literal, a full match fails the clause
+    int satisfied = out.new_label();
+    for (size_t i = 0; i < test.size(); i++) {
+        bool last = (i + 1 == test.size());
+        emit_atom(out, test[i], last ? clause_fail : Emitter::kNext, satisfied);
+    }
+    out.bind(satisfied);
+}
+
+} // namespace
+
+bool PacketFilter::compile(const std::string& expression) {
+    error_.clear();
+
+    Parser parser(expression);
+    if (parser.empty()) {
+        expression_ = expression;
+        program_.clear();
+        return true;
+    }
+
+    NodePtr root = parser.parse();
+    if (!root) {
+        error_ = parser.error();
+        return false;
+    }
+
+    std::vector<Clause> clauses;
+    if (!to_clauses(*root, false, clauses)) {
+        error_ = "expression too complex";
+        return false;
+    }
+
+    // Each clause falls through to "accept"; a failed test skips to the next
+    Emitter out;
+    for (const Clause& clause : clauses) {
+        int next_clause = out.new_label();
+        for (const Literal& literal : clause) {
+            emit_literal(out, literal, next_clause);
+        }
+        out.op(BPF_RET | BPF_K, kAcceptLength);
+        out.bind(next_clause);
+    }
+    out.op(BPF_RET | BPF_K, 0);
+
+    std::vector<struct sock_filter> program;
+    if (!out.finish(program, error_)) {
+        return false;
+    }
+
+    expression_ = expression;
+    program_.swap(program);
+    return true;
+}
+
+bool PacketFilter::attach(int fd) const {
+    if (program_.empty()) {
+        return detach(fd);
+    }
+
+    struct sock_fprog fprog;
+    fprog.len = static_cast<unsigned short>(program_.size());
+    fprog.filter = const_cast<struct sock_filter*>(program_.data());
+
+    if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0) {
+        std::cerr << "Failed to attach packet filter: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PacketFilter::detach(int fd) {
+    int unused = 0;
+    if (setsockopt(fd, SOL_SOCKET, SO_DETACH_FILTER, &unused, sizeof(unused)) < 0 &&
+        errno != ENOENT) {
+        std::cerr << "Failed to detach packet filter: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace embedded_test
@@ -0,0 +1,85 @@
+/**================================================================================
+* FILE: packet_filter.h
+
+* Purpose:
+* 1. Compile simple match expressions into classic BPF socket filters
+* 2. Lets the kernel drop traffic that is not meant for the test
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef PACKET_FILTER_H
+#define PACKET_FILTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <linux/filter.h>
+
+namespace embedded_test {
+
+//Classic BPF program built from a match expression
+//
+//Primitives (Ethernet II frames, untagged):
+//  ether type 0x88b5          ether src|dst|host aa:bb:cc:dd:ee:ff
+//  ip | ip6 | arp             ip src|dst|host 192.168.1.10
+//  ip proto 17                udp | tcp | icmp
+//  udp|tcp [src|dst] port 5000
+//  port 5000                  (UDP or TCP, either direction)
+//  byte|half|word[offset] [& mask] ==|!= value
+//
+//Combine with and/&&, or/||, not/! and parentheses; "and" binds tighter
+//than "or". An empty expression matches everything.
+//Example: "ether type 0x88b5 or (udp port 5000 and ip src 10.0.0.2)"
+
+class PacketFilter {
+public:
+    PacketFilter() {}
+
+    //Compile an expression, replacing any previous program
+    //param expression Match expression
+    //return false on a syntax error (see error())
+
+    bool compile(const std::string& expression);
+
+    //Expression of the last successful compile
+
+    const std::string& expression() const { return expression_; }
+
+    //Description of the last compile failure
+
+    const std::string& error() const { return error_; }
+
+    //true if the last compile produced an accept-all program
+
+    bool matches_all() const { return program_.empty(); }
+
+    //Instructions for SO_ATTACH_FILTER (empty when matches_all())
+
+    const std::vector<struct sock_filter>& program() const { return program_; }
+
+    //Attach the program to a socket (replaces any filter already there);
+    //an accept-all program detaches the current filter instead
+    //param fd Socket descriptor
+    //return true if successful
+
+    bool attach(int fd) const;
+
+    //Remove any filter from a socket
+    //param fd Socket descriptor
+    //return true if successful
+
+    static bool detach(int fd);
+
+private:
+    std::string expression_;
+    std::string error_;
+    std::vector<struct sock_filter> program_;
+};
+
+} // namespace embedded_test
+
+#endif // PACKET_FILTER_H
@@ -0,0 +1,185 @@
+/**================================================================================
+* FILE: packet_pool.cpp
+
+* Purpose:
+* 1. Implementation of the slab packet pool and refcounted buffers
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "packet_pool.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace embedded_test {
+
+// Buffers start on their own cache line so neighbours never share one
+static const size_t kCacheLine = 64;
+
+// PacketBuffer Implementation
+
+PacketBuffer::PacketBuffer(const PacketBuffer& other) : slot_(other.slot_) {
+    if (slot_ != nullptr) {
+        slot_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+PacketBuffer& PacketBuffer::operator=(const PacketBuffer& other) {
+    if (this != &other) {
+        if (other.slot_ != nullptr) {
+            other.slot_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        reset();
+        slot_ = other.slot_;
+    }
+    return *this;
+}
+
+PacketBuffer& PacketBuffer::operator=(PacketBuffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        slot_ = other.slot_;
+        other.slot_ = nullptr;
+    }
+    return *this;
+}
+
+void PacketBuffer::reset() {
+    if (slot_ == nullptr) {
+        return;
+    }
+
+    if (slot_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        slot_->pool->release(slot_);
+    }
+    slot_ = nullptr;
+}
+
+void PacketBuffer::set_size(size_t length) {
+    size_t limit = capacity();
+    slot_->length = static_cast<uint32_t>(length < limit ? length : limit);
+}
+
+size_t PacketBuffer::capacity() const {
+    return slot_ != nullptr ? slot_->pool->buffer_size() : 0;
+}
+
+PacketBuffer::operator ByteSpan() const {
+    if (slot_ == nullptr) {
+        return ByteSpan();
+    }
+    return ByteSpan(slot_->data, slot_->length);
+}
+
+// PacketPool Implementation
+
+PacketPool::PacketPool(size_t buffer_size, size_t buffers_per_slab, size_t max_slabs)
+    : buffer_size_(buffer_size),
+      stride_((buffer_size + kCacheLine - 1) / kCacheLine * kCacheLine),
+      buffers_per_slab_(buffers_per_slab > 0 ? buffers_per_slab : 1),
+      max_slabs_(max_slabs > 0 ? max_slabs : 1),
+      acquires_(0),
+      exhausted_(0) {
+    if (stride_ == 0) {
+        stride_ = kCacheLine;
+    }
+    slabs_.reserve(max_slabs_);
+}
+
+PacketPool::~PacketPool() {
+    if (free_.size() != slabs_.size() * buffers_per_slab_) {
+        std::cerr << "Warning: PacketPool destroyed with buffers still in use" << std::endl;
+    }
+
+    for (Slab& slab : slabs_) {
+        std::free(slab.memory);
+    }
+}
+
+PacketBuffer PacketPool::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (free_.empty() && !add_slab()) {
+        exhausted_++;
+        return PacketBuffer();
+    }
+
+    PacketSlot* slot = free_.back();
+    free_.pop_back();
+    acquires_++;
+
+    slot->length = 0;
+    slot->timestamp_ns = 0;
+    slot->refs.store(1, std::memory_order_relaxed);
+
+    return PacketBuffer(slot);
+}
+
+bool PacketPool::reserve(size_t buffers) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    while (slabs_.size() * buffers_per_slab_ < buffers) {
+        if (!add_slab()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t PacketPool::available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_.size();
+}
+
+PoolStats PacketPool::get_statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    PoolStats stats;
+    stats.slabs = slabs_.size();
+    stats.capacity = slabs_.size() * buffers_per_slab_;
+    stats.in_use = stats.capacity - free_.size();
+    stats.acquires = acquires_;
+    stats.exhausted = exhausted_;
+    return stats;
+}
+
+// Private helper methods
+
+bool PacketPool::add_slab() {
+    if (slabs_.size() >= max_slabs_) {
+        return false;
+    }
+
+    void* memory = nullptr;
+    if (posix_memalign(&memory, kCacheLine, stride_ * buffers_per_slab_) != 0) {
+        std::cerr << "Failed to allocate packet slab" << std::endl;
+        return false;
+    }
+
+    Slab slab;
+    slab.memory = static_cast<uint8_t*>(memory);
+    slab.slots.reset(new PacketSlot[buffers_per_slab_]);
+
+    // The free list never reallocates between slab additions
+    free_.reserve((slabs_.size() + 1) * buffers_per_slab_);
+
+    // Pushed in reverse so buffers are handed out in address order
+    for (size_t i = buffers_per_slab_; i > 0; i--) {
+        PacketSlot& slot = slab.slots[i - 1];
+        slot.data = slab.memory + (i - 1) * stride_;
+        slot.pool = this;
+        free_.push_back(&slot);
+    }
+
+    slabs_.push_back(std::move(slab));
+    return true;
+}
+
+void PacketPool::release(PacketSlot* slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(slot);
+}
+
+} // namespace embedded_test
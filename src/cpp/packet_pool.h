@@ -0,0 +1,186 @@
+/**================================================================================
+* FILE: packet_pool.h
+
+* Purpose:
+* 1. Slab allocator of fixed-size, cache-aligned packet buffers
+* 2. Refcounted buffer handles shared by TX, RX, capture and validation
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef PACKET_POOL_H
+#define PACKET_POOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace embedded_test {
+
+class PacketPool;
+
+//Read-only view of caller-owned bytes
+//Lets frames be passed without copying them into a std::vector first;
+//converts implicitly from std::vector<uint8_t>
+
+struct ByteSpan {
+    const uint8_t* ptr;
+    size_t len;
+    
+    ByteSpan() : ptr(nullptr), len(0) {}
+    ByteSpan(const uint8_t* data, size_t length) : ptr(data), len(length) {}
+    ByteSpan(const std::vector<uint8_t>& data) : ptr(data.data()), len(data.size()) {}
+    
+    const uint8_t* data() const { return ptr; }
+    size_t size() const { return len; }
+    const uint8_t* begin() const { return ptr; }
+    const uint8_t* end() const { return ptr + len; }
+    uint8_t operator[](size_t index) const { return ptr[index]; }
+};
+
+//Bookkeeping for one pooled buffer (lives beside the slab, not in it)
+
+struct PacketSlot {
+    std::atomic<uint32_t> refs;
+    uint32_t length;
+    uint64_t timestamp_ns;
+    uint8_t* data;
+    PacketPool* pool;
+
+    PacketSlot() : refs(0), length(0), timestamp_ns(0), data(nullptr), pool(nullptr) {}
+};
+
+//Refcounted handle to a pooled buffer
+//Copying shares the buffer; it returns to the pool when the last handle
+//goes away. The pool must outlive every handle taken from it
+
+class PacketBuffer {
+public:
+    PacketBuffer() : slot_(nullptr) {}
+    ~PacketBuffer() { reset(); }
+
+    PacketBuffer(const PacketBuffer& other);
+    PacketBuffer(PacketBuffer&& other) noexcept : slot_(other.slot_) { other.slot_ = nullptr; }
+    PacketBuffer& operator=(const PacketBuffer& other);
+    PacketBuffer& operator=(PacketBuffer&& other) noexcept;
+
+    //Drop this handle's reference
+
+    void reset();
+
+    bool valid() const { return slot_ != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    uint8_t* data() { return slot_->data; }
+    const uint8_t* data() const { return slot_->data; }
+
+    //Valid bytes in the buffer
+
+    size_t size() const { return slot_ != nullptr ? slot_->length : 0; }
+
+    //Set the valid length (clamped to capacity)
+
+    void set_size(size_t length);
+
+    //Usable bytes in the buffer
+
+    size_t capacity() const;
+
+    uint64_t timestamp_ns() const { return slot_ != nullptr ? slot_->timestamp_ns : 0; }
+    void set_timestamp_ns(uint64_t timestamp_ns) { slot_->timestamp_ns = timestamp_ns; }
+
+    //Number of handles sharing this buffer
+
+    uint32_t use_count() const { return slot_ != nullptr ? slot_->refs.load(std::memory_order_relaxed) : 0; }
+
+    //View of the valid bytes, for APIs that take ByteSpan
+
+    operator ByteSpan() const;
+
+private:
+    friend class PacketPool;
+    explicit PacketBuffer(PacketSlot* slot) : slot_(slot) {}
+
+    PacketSlot* slot_;
+};
+
+//Pool counters
+
+struct PoolStats {
+    uint64_t slabs;             // slabs allocated so far
+    uint64_t capacity;          // buffers across all slabs
+    uint64_t in_use;            // buffers currently held by handles
+    uint64_t acquires;          // successful acquire() calls
+    uint64_t exhausted;         // acquire() calls that found no free buffer
+
+    PoolStats() : slabs(0), capacity(0), in_use(0), acquires(0), exhausted(0) {}
+};
+
+//Pool of fixed-size buffers carved out of cache-aligned slabs
+//Memory is only allocated when a slab is added; after warm-up, acquire()
+//and release are a lock-protected push/pop on a preallocated free list
+
+class PacketPool {
+public:
+    //param buffer_size Usable bytes per buffer (rounded up to a cache line)
+    //param buffers_per_slab Buffers added each time the pool grows
+    //param max_slabs Growth limit; acquire() fails once it is reached
+
+    explicit PacketPool(size_t buffer_size = 2048, size_t buffers_per_slab = 1024,
+                        size_t max_slabs = 64);
+    ~PacketPool();
+
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    //Take a free buffer (size 0, refcount 1)
+    //return Empty handle if the pool is exhausted
+
+    PacketBuffer acquire();
+
+    //Grow the pool ahead of time so the hot path never allocates
+    //param buffers Minimum total capacity wanted
+    //return true if the capacity was reached
+
+    bool reserve(size_t buffers);
+
+    size_t buffer_size() const { return buffer_size_; }
+
+    //Buffers ready to be acquired without growing
+
+    size_t available() const;
+
+    PoolStats get_statistics() const;
+
+private:
+    friend class PacketBuffer;
+
+    struct Slab {
+        uint8_t* memory;
+        std::unique_ptr<PacketSlot[]> slots;
+    };
+
+    size_t buffer_size_;
+    size_t stride_;
+    size_t buffers_per_slab_;
+    size_t max_slabs_;
+
+    mutable std::mutex mutex_;
+    std::vector<Slab> slabs_;
+    std::vector<PacketSlot*> free_;
+    uint64_t acquires_;
+    uint64_t exhausted_;
+
+    // Helper methods
+    bool add_slab();
+    void release(PacketSlot* slot);
+};
+
+} // namespace embedded_test
+
+#endif // PACKET_POOL_H
@@ -0,0 +1,326 @@
+/**================================================================================
+* FILE: packet_ring.cpp
+
+* Purpose:
+* 1. Implementation of the PACKET_MMAP ring buffers
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "packet_ring.h"
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <linux/if_packet.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace embedded_test {
+
+// Nominal RX frame size; V3 packs variable-sized frames into each block
+static const uint32_t kRxNominalFrameSize = 2048;
+
+PacketRing::PacketRing()
+    : fd_(-1),
+      map_(nullptr),
+      map_size_(0),
+      tx_ring_(nullptr),
+      tx_frame_size_(0),
+      tx_frame_count_(0),
+      tx_head_(0),
+      tx_pending_(0),
+      tx_rejected_(0),
+      rx_ring_(nullptr),
+      rx_block_size_(0),
+      rx_block_count_(0),
+      rx_block_(0),
+      rx_remaining_(0),
+      rx_frame_(nullptr),
+      rx_holding_(false) {
+}
+
+PacketRing::~PacketRing() {
+    release();
+}
+
+bool PacketRing::setup(int fd, const RingConfig& config) {
+    release();
+
+    if (!config.tx_enabled && !config.rx_enabled) {
+        return true;
+    }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (config.tx_enabled &&
+        (config.tx_frame_size < TPACKET3_HDRLEN ||
+         config.tx_frame_size % TPACKET_ALIGNMENT != 0 ||
+         config.tx_block_size % page_size != 0 ||
+         config.tx_block_size % config.tx_frame_size != 0)) {
+        std::cerr << "Invalid TX ring geometry" << std::endl;
+        return false;
+    }
+    if (config.rx_enabled &&
+        (config.rx_block_size % page_size != 0 || config.rx_block_count == 0)) {
+        std::cerr << "Invalid RX ring geometry" << std::endl;
+        return false;
+    }
+
+    int version = TPACKET_V3;
+    if (setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+        std::cerr << "Failed to select TPACKET_V3: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct tpacket_req3 rx_req;
+    struct tpacket_req3 tx_req;
+    memset(&rx_req, 0, sizeof(rx_req));
+    memset(&tx_req, 0, sizeof(tx_req));
+
+    if (config.rx_enabled) {
+        rx_req.tp_block_size = config.rx_block_size;
+        rx_req.tp_block_nr = config.rx_block_count;
+        rx_req.tp_frame_size = kRxNominalFrameSize;
+        rx_req.tp_frame_nr = (config.rx_block_size / rx_req.tp_frame_size) * config.rx_block_count;
+        rx_req.tp_retire_blk_tov = config.rx_retire_timeout_ms;
+
+        if (setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &rx_req, sizeof(rx_req)) < 0) {
+            std::cerr << "Failed to create RX ring: " << strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    if (config.tx_enabled) {
+        // Round the frame count up to whole blocks so frame N lives at N * frame_size
+        uint32_t frames_per_block = config.tx_block_size / config.tx_frame_size;
+        uint32_t block_count = (config.tx_frame_count + frames_per_block - 1) / frames_per_block;
+
+        tx_req.tp_block_size = config.tx_block_size;
+        tx_req.tp_block_nr = block_count;
+        tx_req.tp_frame_size = config.tx_frame_size;
+        tx_req.tp_frame_nr = block_count * frames_per_block;
+
+        if (setsockopt(fd, SOL_PACKET, PACKET_TX_RING, &tx_req, sizeof(tx_req)) < 0) {
+            std::cerr << "Failed to create TX ring: " << strerror(errno) << std::endl;
+            detach_rings(fd, config.rx_enabled, false);
+            return false;
+        }
+    }
+
+    // Both rings share one mapping: RX first, then TX
+    size_t rx_size = static_cast<size_t>(rx_req.tp_block_size) * rx_req.tp_block_nr;
+    size_t tx_size = static_cast<size_t>(tx_req.tp_block_size) * tx_req.tp_block_nr;
+    map_size_ = rx_size + tx_size;
+
+    void* map = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_LOCKED, fd, 0);
+    if (map == MAP_FAILED) {
+        // MAP_LOCKED fails without CAP_IPC_LOCK or enough RLIMIT_MEMLOCK
+        map = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (map == MAP_FAILED) {
+        std::cerr << "Failed to map packet rings: " << strerror(errno) << std::endl;
+        detach_rings(fd, config.rx_enabled, config.tx_enabled);
+        map_size_ = 0;
+        return false;
+    }
+
+    fd_ = fd;
+    map_ = static_cast<uint8_t*>(map);
+
+    if (config.rx_enabled) {
+        rx_ring_ = map_;
+        rx_block_size_ = rx_req.tp_block_size;
+        rx_block_count_ = rx_req.tp_block_nr;
+        rx_block_ = 0;
+        rx_remaining_ = 0;
+        rx_frame_ = nullptr;
+        rx_holding_ = false;
+    }
+
+    if (config.tx_enabled) {
+        tx_ring_ = map_ + rx_size;
+        tx_frame_size_ = tx_req.tp_frame_size;
+        tx_frame_count_ = tx_req.tp_frame_nr;
+        tx_head_ = 0;
+        tx_pending_ = 0;
+        tx_rejected_ = 0;
+    }
+
+    return true;
+}
+
+void PacketRing::release() {
+    if (map_ != nullptr) {
+        munmap(map_, map_size_);
+    }
+
+    // Detach the rings so plain send()/recv() work again on this socket
+    if (fd_ >= 0) {
+        detach_rings(fd_, rx_ring_ != nullptr, tx_ring_ != nullptr);
+    }
+
+    fd_ = -1;
+    map_ = nullptr;
+    map_size_ = 0;
+    tx_ring_ = nullptr;
+    tx_frame_size_ = 0;
+    tx_frame_count_ = 0;
+    tx_head_ = 0;
+    tx_pending_ = 0;
+    rx_ring_ = nullptr;
+    rx_block_size_ = 0;
+    rx_block_count_ = 0;
+    rx_block_ = 0;
+    rx_remaining_ = 0;
+    rx_frame_ = nullptr;
+    rx_holding_ = false;
+}
+
+size_t PacketRing::tx_max_frame() const {
+    if (tx_ring_ == nullptr) {
+        return 0;
+    }
+    return tx_frame_size_ - (TPACKET3_HDRLEN - sizeof(struct sockaddr_ll));
+}
+
+bool PacketRing::tx_enqueue(const uint8_t* data, size_t len) {
+    if (tx_ring_ == nullptr || len == 0 || len > tx_max_frame()) {
+        return false;
+    }
+
+    if (!tx_slot_free(tx_head_)) {
+        // Ring is full: push everything out and wait for the kernel to
+        // hand the slots back
+        if (tx_flush(true) < 0 || !tx_slot_free(tx_head_)) {
+            return false;
+        }
+    }
+
+    uint8_t* frame = tx_frame(tx_head_);
+    struct tpacket3_hdr* hdr = reinterpret_cast<struct tpacket3_hdr*>(frame);
+
+    memcpy(frame + TPACKET3_HDRLEN - sizeof(struct sockaddr_ll), data, len);
+    hdr->tp_next_offset = 0;
+    hdr->tp_len = static_cast<uint32_t>(len);
+    hdr->tp_snaplen = static_cast<uint32_t>(len);
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+
+    tx_head_ = (tx_head_ + 1) % tx_frame_count_;
+    tx_pending_++;
+
+    return true;
+}
+
+int64_t PacketRing::tx_flush(bool wait) {
+    if (tx_ring_ == nullptr) {
+        return -1;
+    }
+    if (tx_pending_ == 0 && !wait) {
+        return 0;
+    }
+
+    ssize_t sent = send(fd_, nullptr, 0, wait ? 0 : MSG_DONTWAIT);
+    tx_pending_ = 0;
+
+    if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+            return 0;
+        }
+        return -1;
+    }
+
+    return sent;
+}
+
+bool PacketRing::rx_next(PacketView& view) {
+    if (rx_ring_ == nullptr) {
+        return false;
+    }
+
+    struct tpacket_block_desc* block =
+        reinterpret_cast<struct tpacket_block_desc*>(rx_block_desc(rx_block_));
+
+    // The caller has moved past the last frame of the held block
+    if (rx_holding_ && rx_remaining_ == 0) {
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        rx_holding_ = false;
+        rx_block_ = (rx_block_ + 1) % rx_block_count_;
+        block = reinterpret_cast<struct tpacket_block_desc*>(rx_block_desc(rx_block_));
+    }
+
+    if (!rx_holding_) {
+        uint32_t status = __atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE);
+        if (!(status & TP_STATUS_USER)) {
+            return false;
+        }
+
+        rx_holding_ = true;
+        rx_remaining_ = block->hdr.bh1.num_pkts;
+        rx_frame_ = reinterpret_cast<uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+
+        if (rx_remaining_ == 0) {
+            return rx_next(view);
+        }
+    }
+
+    struct tpacket3_hdr* hdr = reinterpret_cast<struct tpacket3_hdr*>(rx_frame_);
+    view.data = rx_frame_ + hdr->tp_mac;
+    view.length = hdr->tp_snaplen;
+    view.timestamp_ns = static_cast<uint64_t>(hdr->tp_sec) * 1000000000ULL + hdr->tp_nsec;
+    view.hardware_timestamp = (hdr->tp_status & TP_STATUS_TS_RAW_HARDWARE) != 0;
+
+    // The link-layer address follows the aligned frame header
+    const struct sockaddr_ll* addr = reinterpret_cast<const struct sockaddr_ll*>(
+        rx_frame_ + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+    view.outgoing = (addr->sll_pkttype == PACKET_OUTGOING);
+
+    rx_frame_ += hdr->tp_next_offset;
+    rx_remaining_--;
+
+    return true;
+}
+
+// Private helper methods
+
+uint8_t* PacketRing::tx_frame(uint32_t index) const {
+    return tx_ring_ + static_cast<size_t>(index) * tx_frame_size_;
+}
+
+bool PacketRing::tx_slot_free(uint32_t index) {
+    struct tpacket3_hdr* hdr = reinterpret_cast<struct tpacket3_hdr*>(tx_frame(index));
+    uint32_t status = __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE);
+
+    if (status == TP_STATUS_AVAILABLE) {
+        return true;
+    }
+
+    if (status & TP_STATUS_WRONG_FORMAT) {
+        // Kernel refused this frame; count it and recycle the slot
+        tx_rejected_++;
+        __atomic_store_n(&hdr->tp_status, TP_STATUS_AVAILABLE, __ATOMIC_RELAXED);
+        return true;
+    }
+
+    return false;
+}
+
+uint8_t* PacketRing::rx_block_desc(uint32_t index) const {
+    return rx_ring_ + static_cast<size_t>(index) * rx_block_size_;
+}
+
+void PacketRing::detach_rings(int fd, bool rx, bool tx) {
+    struct tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+
+    if (rx) {
+        setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+    }
+    if (tx) {
+        setsockopt(fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req));
+    }
+}
+
+} // namespace embedded_test
@@ -0,0 +1,148 @@
+/**================================================================================
+* FILE: packet_ring.h
+
+* Purpose:
+* 1. PACKET_MMAP ring buffers shared with the kernel for the AF_PACKET fast path
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef PACKET_RING_H
+#define PACKET_RING_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace embedded_test {
+
+//Ring geometry
+//frame_size must be a multiple of 16 and large enough for one frame plus
+//the tpacket header; block_size must be a multiple of the page size and
+//of frame_size
+
+struct RingConfig {
+    bool tx_enabled;
+    uint32_t tx_frame_size;
+    uint32_t tx_frame_count;
+    uint32_t tx_block_size;
+
+    bool rx_enabled;
+    uint32_t rx_block_size;
+    uint32_t rx_block_count;
+    uint32_t rx_retire_timeout_ms;  // hand a partly filled block to user space after this
+
+    RingConfig() : tx_enabled(false),
+                   tx_frame_size(2048), tx_frame_count(1024),
+                   tx_block_size(1 << 16),
+                   rx_enabled(false),
+                   rx_block_size(1 << 20), rx_block_count(32),
+                   rx_retire_timeout_ms(10) {}
+};
+
+//Zero-copy view of a received frame
+//Points into the RX ring; valid until the next receive call
+
+struct PacketView {
+    const uint8_t* data;
+    uint32_t length;
+    uint64_t timestamp_ns;
+    bool outgoing;          // sent by this host (an AF_PACKET socket sees its own TX)
+    bool hardware_timestamp; // timestamp_ns comes from the NIC clock
+
+    PacketView() : data(nullptr), length(0), timestamp_ns(0), outgoing(false),
+                   hardware_timestamp(false) {}
+};
+
+//Memory-mapped TPACKET_V3 rings attached to an AF_PACKET socket
+//TX frames are written straight into the shared ring and handed to the
+//kernel with one send() kick per batch instead of one syscall per frame.
+//RX frames are delivered by the kernel in blocks that are walked in place
+//and returned to the kernel once the caller has moved past them
+
+class PacketRing {
+public:
+    PacketRing();
+    ~PacketRing();
+
+    PacketRing(const PacketRing&) = delete;
+    PacketRing& operator=(const PacketRing&) = delete;
+
+    //Attach rings to a bound AF_PACKET socket and map them
+    //param fd Socket descriptor (must not have a ring yet)
+    //param config Ring geometry
+    //return true if successful
+
+    bool setup(int fd, const RingConfig& config);
+
+    //Unmap and detach the rings (the socket itself is left open)
+
+    void release();
+
+    bool has_tx() const { return tx_ring_ != nullptr; }
+    bool has_rx() const { return rx_ring_ != nullptr; }
+
+    //Largest frame the TX ring can carry
+
+    size_t tx_max_frame() const;
+
+    //Copy one frame into the next free TX slot
+    //Kicks the kernel and waits once if the ring is full
+    //param data Frame data
+    //param len Frame length
+    //return true if the frame was queued
+
+    bool tx_enqueue(const uint8_t* data, size_t len);
+
+    //Hand all queued TX frames to the kernel
+    //param wait Block until the kernel has transmitted them
+    //return Number of bytes accepted by the kernel, -1 on error
+
+    int64_t tx_flush(bool wait);
+
+    //Frames queued since the last flush
+
+    uint32_t tx_pending() const { return tx_pending_; }
+
+    //Frames the kernel rejected as malformed (TP_STATUS_WRONG_FORMAT)
+
+    uint64_t tx_rejected() const { return tx_rejected_; }
+
+    //Take the next received frame without copying it
+    //Returns the previous block to the kernel once it has been walked
+    //param view Filled with a pointer into the ring
+    //return true if a frame was available
+
+    bool rx_next(PacketView& view);
+
+private:
+    int fd_;
+    uint8_t* map_;
+    size_t map_size_;
+
+    uint8_t* tx_ring_;
+    uint32_t tx_frame_size_;
+    uint32_t tx_frame_count_;
+    uint32_t tx_head_;
+    uint32_t tx_pending_;
+    uint64_t tx_rejected_;
+
+    uint8_t* rx_ring_;
+    uint32_t rx_block_size_;
+    uint32_t rx_block_count_;
+    uint32_t rx_block_;
+    uint32_t rx_remaining_;
+    uint8_t* rx_frame_;
+    bool rx_holding_;
+
+    // Helper methods
+    uint8_t* tx_frame(uint32_t index) const;
+    bool tx_slot_free(uint32_t index);
+    uint8_t* rx_block_desc(uint32_t index) const;
+    static void detach_rings(int fd, bool rx, bool tx);
+};
+
+} // namespace embedded_test
+
+#endif // PACKET_RING_H
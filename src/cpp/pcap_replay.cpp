@@ -0,0 +1,461 @@
+/**================================================================================
+* FILE: pcap_replay.cpp
+
+* Purpose:
+* 1. Implementation of the pcap/pcapng replayer
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "pcap_replay.h"
+#include "traffic_generator.h"
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace embedded_test {
+
+// Frames handed to the kernel per send call when several are due
+static const size_t kMaxBurst = 64;
+
+static const uint16_t kLinkTypeEthernet = 1;
+
+// pcap magic numbers as read in host order
+static const uint32_t kPcapMicro = 0xA1B2C3D4;
+static const uint32_t kPcapNano = 0xA1B23C4D;
+static const uint32_t kPcapMicroSwapped = 0xD4C3B2A1;
+static const uint32_t kPcapNanoSwapped = 0x4D3CB2A1;
+
+// pcapng block types
+static const uint32_t kSectionHeaderBlock = 0x0A0D0D0A;
+static const uint32_t kInterfaceDescriptionBlock = 0x00000001;
+static const uint32_t kPacketBlock = 0x00000002;
+static const uint32_t kSimplePacketBlock = 0x00000003;
+static const uint32_t kEnhancedPacketBlock = 0x00000006;
+static const uint32_t kByteOrderMagic = 0x1A2B3C4D;
+static const uint16_t kOptIfTsResol = 9;
+
+static uint16_t read16(const uint8_t* p, bool swap) {
+    uint16_t value;
+    memcpy(&value, p, sizeof(value));
+    return swap ? __builtin_bswap16(value) : value;
+}
+
+static uint32_t read32(const uint8_t* p, bool swap) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return swap ? __builtin_bswap32(value) : value;
+}
+
+// Timestamp in units_per_second ticks to nanoseconds
+static uint64_t ticks_to_ns(uint64_t ticks, uint64_t units_per_second) {
+    if (units_per_second == 1000000000ULL) {
+        return ticks;
+    }
+    uint64_t seconds = ticks / units_per_second;
+    uint64_t fraction = ticks % units_per_second;
+    return seconds * 1000000000ULL +
+           static_cast<uint64_t>(static_cast<long double>(fraction) * 1e9L / units_per_second);
+}
+
+PcapReplay::PcapReplay(FastComms& comms)
+    : comms_(comms),
+      map_(nullptr),
+      map_size_(0),
+      stop_requested_(false) {
+}
+
+PcapReplay::~PcapReplay() {
+    unmap();
+}
+
+bool PcapReplay::load(const std::string& path) {
+    unmap();
+    records_.clear();
+    error_.clear();
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error_ = "Cannot open " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < 4) {
+        error_ = "Empty or unreadable capture file " + path;
+        ::close(fd);
+        return false;
+    }
+
+    void* map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        error_ = "Cannot map " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    map_ = static_cast<const uint8_t*>(map);
+    map_size_ = static_cast<size_t>(st.st_size);
+    madvise(map, map_size_, MADV_WILLNEED);
+
+    uint32_t magic = read32(map_, false);
+    bool ok;
+    if (magic == kSectionHeaderBlock) {
+        ok = parse_pcapng();
+    } else if (magic == kPcapMicro || magic == kPcapNano ||
+               magic == kPcapMicroSwapped || magic == kPcapNanoSwapped) {
+        ok = parse_pcap();
+    } else {
+        error_ = "Not a pcap or pcapng file: " + path;
+        ok = false;
+    }
+
+    if (!ok) {
+        records_.clear();
+        unmap();
+        return false;
+    }
+    if (records_.empty()) {
+        error_ = "No packets in " + path;
+        unmap();
+        return false;
+    }
+
+    return true;
+}
+
+double PcapReplay::capture_duration_s() const {
+    if (records_.size() < 2) {
+        return 0.0;
+    }
+    uint64_t first = records_.front().timestamp_ns;
+    uint64_t last = records_.back().timestamp_ns;
+    return last > first ? (last - first) / 1e9 : 0.0;
+}
+
+ReplayReport PcapReplay::run(const ReplayConfig& config) {
+    ReplayReport report;
+    stop_requested_.store(false);
+
+    if (records_.empty()) {
+        return report;
+    }
+
+    size_t count = records_.size();
+    bool top_speed = (config.timing == ReplayTiming::TOP_SPEED);
+
+    // Send offset of every frame within one pass. Capture timestamps that
+    // step backwards are held at the previous value
+    std::vector<double> offsets(count, 0.0);
+    double pass_ns = 0.0;
+
+    if (config.timing == ReplayTiming::ORIGINAL) {
+        double speed = config.speed > 0 ? config.speed : 1.0;
+        uint64_t first = records_[0].timestamp_ns;
+        uint64_t latest = first;
+        for (size_t i = 0; i < count; i++) {
+            latest = std::max(latest, records_[i].timestamp_ns);
+            offsets[i] = (latest - first) / speed;
+        }
+        // The next pass starts one average gap after the last frame
+        double span = offsets[count - 1];
+        pass_ns = span + (count > 1 ? span / (count - 1) : 0.0);
+    } else if (config.timing == ReplayTiming::FIXED_RATE) {
+        double gap = config.pps > 0 ? 1e9 / config.pps : 0.0;
+        for (size_t i = 0; i < count; i++) {
+            offsets[i] = i * gap;
+        }
+        pass_ns = count * gap;
+    }
+
+    bool rewrite_dst = config.dst_mac.size() == 6;
+    bool rewrite_src = config.src_mac.size() == 6;
+    size_t max_frame = 0;
+    if (rewrite_dst || rewrite_src) {
+        for (const Record& record : records_) {
+            max_frame = std::max<size_t>(max_frame, record.length);
+        }
+    }
+    std::vector<uint8_t> scratch(kMaxBurst * max_frame);
+
+    std::vector<ByteSpan> burst;
+    std::vector<double> due_times;
+    std::vector<uint8_t> accepted;
+    burst.reserve(kMaxBurst);
+    due_times.reserve(kMaxBurst);
+
+    uint64_t spin_threshold_ns = static_cast<uint64_t>(config.spin_threshold_us) * 1000;
+    uint32_t passes = 0;
+    size_t index = 0;
+    double last_due = 0.0;
+
+    auto finished = [&]() {
+        return config.loops != 0 && passes >= config.loops;
+    };
+
+    // Fine-grained sleeps need the timer slack off for this thread
+    int old_slack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+    prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+
+    uint64_t start = monotonic_ns();
+
+    while (!finished() && !stop_requested_.load(std::memory_order_relaxed)) {
+        if (!top_speed) {
+            double due = passes * pass_ns + offsets[index];
+            if (due > monotonic_ns() - start) {
+                wait_until(start + static_cast<uint64_t>(due), spin_threshold_ns);
+            }
+        }
+
+        // Everything due by now goes out together
+        uint64_t now = monotonic_ns() - start;
+        burst.clear();
+        due_times.clear();
+        uint64_t burst_bytes = 0;
+
+        while (!finished() && burst.size() < kMaxBurst) {
+            double due = passes * pass_ns + offsets[index];
+            if (!top_speed && due > now) {
+                break;
+            }
+
+            const Record& record = records_[index];
+            if (max_frame > 0) {
+                uint8_t* copy = scratch.data() + burst.size() * max_frame;
+                memcpy(copy, record.data, record.length);
+                if (rewrite_dst && record.length >= 6) {
+                    memcpy(copy, config.dst_mac.data(), 6);
+                }
+                if (rewrite_src && record.length >= 12) {
+                    memcpy(copy + 6, config.src_mac.data(), 6);
+                }
+                burst.push_back(ByteSpan(copy, record.length));
+            } else {
+                burst.push_back(ByteSpan(record.data, record.length));
+            }
+            due_times.push_back(due);
+            burst_bytes += record.length;
+
+            if (++index == count) {
+                index = 0;
+                passes++;
+            }
+        }
+
+        if (burst.empty()) {
+            continue;
+        }
+
+        uint64_t sent_at = monotonic_ns() - start;
+        size_t ok;
+        if (burst.size() == 1) {
+            ok = comms_.send_packet(burst[0]) ? 1 : 0;
+        } else {
+            ok = static_cast<size_t>(std::max(0, comms_.burst_send(burst, accepted)));
+        }
+
+        report.totals.packets_sent += ok;
+        report.totals.errors += burst.size() - ok;
+        if (ok == burst.size()) {
+            report.totals.bytes_sent += burst_bytes;
+        } else {
+            for (size_t i = 0; i < burst.size(); i++) {
+                if (burst.size() == 1 || accepted[i]) {
+                    report.totals.bytes_sent += burst[i].size();
+                }
+            }
+        }
+
+        if (!top_speed) {
+            for (double due : due_times) {
+                double error = sent_at - due;
+                report.timing_error.record(static_cast<uint64_t>(error < 0 ? -error : error));
+            }
+        }
+        last_due = due_times.back();
+    }
+
+    uint64_t elapsed = monotonic_ns() - start;
+    prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(old_slack > 0 ? old_slack : 50000), 0, 0, 0);
+
+    report.loops = passes;
+    report.elapsed_s = elapsed / 1e9;
+    report.scheduled_s = top_speed ? 0.0 : last_due / 1e9;
+    return report;
+}
+
+void PcapReplay::stop() {
+    stop_requested_.store(true);
+}
+
+// Private helper methods
+
+void PcapReplay::unmap() {
+    if (map_ != nullptr) {
+        munmap(const_cast<uint8_t*>(map_), map_size_);
+        map_ = nullptr;
+        map_size_ = 0;
+    }
+}
+
+bool PcapReplay::parse_pcap() {
+    if (map_size_ < 24) {
+        error_ = "Truncated pcap header";
+        return false;
+    }
+
+    uint32_t magic = read32(map_, false);
+    bool swap = (magic == kPcapMicroSwapped || magic == kPcapNanoSwapped);
+    bool nanoseconds = (magic == kPcapNano || magic == kPcapNanoSwapped);
+
+    // The upper bits of the link type field carry FCS information
+    uint32_t link_type = read32(map_ + 20, swap) & 0xFFFF;
+    if (link_type != kLinkTypeEthernet) {
+        error_ = "Link type " + std::to_string(link_type) + " is not Ethernet";
+        return false;
+    }
+
+    size_t offset = 24;
+    while (offset + 16 <= map_size_) {
+        const uint8_t* header = map_ + offset;
+        uint64_t seconds = read32(header, swap);
+        uint64_t fraction = read32(header + 4, swap);
+        uint32_t captured = read32(header + 8, swap);
+
+        if (offset + 16 + captured > map_size_) {
+            break;          // last record cut short, as left by a killed capture
+        }
+
+        Record record;
+        record.data = header + 16;
+        record.length = captured;
+        record.timestamp_ns = seconds * 1000000000ULL + (nanoseconds ? fraction : fraction * 1000);
+        records_.push_back(record);
+
+        offset += 16 + captured;
+    }
+
+    return true;
+}
+
+bool PcapReplay::parse_pcapng() {
+    struct Interface {
+        uint16_t link_type;
+        uint64_t units_per_second;
+    };
+
+    std::vector<Interface> interfaces;
+    bool swap = false;
+    uint64_t last_timestamp = 0;
+    size_t offset = 0;
+
+    while (offset + 12 <= map_size_) {
+        const uint8_t* block = map_ + offset;
+
+        // The section header type reads the same in either byte order
+        if (read32(block, false) == kSectionHeaderBlock) {
+            uint32_t magic = read32(block + 8, false);
+            if (magic != kByteOrderMagic && magic != __builtin_bswap32(kByteOrderMagic)) {
+                error_ = "Bad pcapng byte-order magic at offset " + std::to_string(offset);
+                return false;
+            }
+            swap = (magic != kByteOrderMagic);
+            interfaces.clear();
+        }
+
+        uint32_t type = read32(block, swap);
+        uint32_t length = read32(block + 4, swap);
+        if (length < 12 || (length & 3) != 0) {
+            error_ = "Corrupt pcapng block at offset " + std::to_string(offset);
+            return false;
+        }
+        if (offset + length > map_size_) {
+            break;          // last block cut short
+        }
+
+        const uint8_t* body_end = block + length - 4;
+
+        if (type == kInterfaceDescriptionBlock && length >= 20) {
+            Interface iface;
+            iface.link_type = read16(block + 8, swap);
+            iface.units_per_second = 1000000;
+
+            const uint8_t* option = block + 16;
+            while (option + 4 <= body_end) {
+                uint16_t code = read16(option, swap);
+                uint16_t option_length = read16(option + 2, swap);
+                if (code == 0 || option + 4 + option_length > body_end) {
+                    break;
+                }
+                if (code == kOptIfTsResol && option_length >= 1) {
+                    uint8_t resolution = option[4];
+                    uint32_t exponent = resolution & 0x7F;
+                    if (resolution & 0x80) {
+                        iface.units_per_second = 1ULL << std::min<uint32_t>(exponent, 63);
+                    } else {
+                        iface.units_per_second = 1;
+                        for (uint32_t i = 0; i < std::min<uint32_t>(exponent, 19); i++) {
+                            iface.units_per_second *= 10;
+                        }
+                    }
+                }
+                option += 4 + ((option_length + 3) & ~3U);
+            }
+            interfaces.push_back(iface);
+        } else if (type == kEnhancedPacketBlock || type == kPacketBlock ||
+                   type == kSimplePacketBlock) {
+            uint32_t interface_id;
+            uint64_t ticks = 0;
+            uint32_t captured;
+            const uint8_t* data;
+
+            if (length < (type == kSimplePacketBlock ? 16U : 32U)) {
+                error_ = "Corrupt packet block at offset " + std::to_string(offset);
+                return false;
+            }
+
+            if (type == kSimplePacketBlock) {
+                // No timestamp: sent right after the previous frame
+                interface_id = 0;
+                captured = std::min<uint32_t>(read32(block + 8, swap), length - 16);
+                data = block + 12;
+            } else {
+                interface_id = (type == kPacketBlock) ? read16(block + 8, swap) : read32(block + 8, swap);
+                ticks = (static_cast<uint64_t>(read32(block + 12, swap)) << 32) | read32(block + 16, swap);
+                captured = read32(block + 20, swap);
+                data = block + 28;
+            }
+
+            if (interface_id >= interfaces.size() || data + captured > body_end) {
+                error_ = "Corrupt packet block at offset " + std::to_string(offset);
+                return false;
+            }
+            const Interface& iface = interfaces[interface_id];
+            if (iface.link_type != kLinkTypeEthernet) {
+                error_ = "Link type " + std::to_string(iface.link_type) + " is not Ethernet";
+                return false;
+            }
+
+            Record record;
+            record.data = data;
+            record.length = captured;
+            record.timestamp_ns = (type == kSimplePacketBlock) ? last_timestamp
+                                                               : ticks_to_ns(ticks, iface.units_per_second);
+            last_timestamp = record.timestamp_ns;
+            records_.push_back(record);
+        }
+
+        offset += length;
+    }
+
+    return true;
+}
+
+} // namespace embedded_test
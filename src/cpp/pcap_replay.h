@@ -0,0 +1,127 @@
+/**================================================================================
+* FILE: pcap_replay.h
+
+* Purpose:
+* 1. Replay pcap/pcapng captures through a FastComms channel
+* 2. Original timing, speed multiplier, fixed pps or top speed
+* 3. Timing error against the capture reported per run
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef PCAP_REPLAY_H
+#define PCAP_REPLAY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "fast_comms.h"
+#include "latency_histogram.h"
+
+namespace embedded_test {
+
+//How send times are chosen
+
+enum class ReplayTiming {
+    ORIGINAL,       // capture gaps divided by speed
+    FIXED_RATE,     // evenly spaced at pps
+    TOP_SPEED       // as fast as the channel accepts
+};
+
+//Replay settings
+
+struct ReplayConfig {
+    ReplayTiming timing;
+    double speed;                   // ORIGINAL: 2.0 replays twice as fast
+    double pps;                     // FIXED_RATE: packets per second
+    uint32_t loops;                 // passes over the file, 0 = until stop()
+    std::vector<uint8_t> dst_mac;   // 6 bytes written over each destination MAC, empty keeps it
+    std::vector<uint8_t> src_mac;   // 6 bytes written over each source MAC, empty keeps it
+    uint32_t spin_threshold_us;     // waits shorter than this are spun
+
+    ReplayConfig() : timing(ReplayTiming::ORIGINAL), speed(1.0), pps(1000.0), loops(1),
+                     spin_threshold_us(50) {}
+};
+
+//Result of one replay run
+
+struct ReplayReport {
+    PacketStats totals;
+    uint32_t loops;                 // passes completed
+    double elapsed_s;
+    double scheduled_s;             // replay length the timing asked for
+    LatencyHistogram timing_error;  // |actual - scheduled| send time per packet, ns (not TOP_SPEED)
+
+    ReplayReport() : loops(0), elapsed_s(0), scheduled_s(0) {}
+};
+
+//Capture file replayer
+//The file is memory-mapped and indexed once by load(); frames are sent
+//straight from the mapping unless MAC rewriting needs a private copy.
+//Frames that are due together go out in one burst_send. Late frames are
+//sent late rather than skipped, and the lateness shows up in timing_error
+
+class PcapReplay {
+public:
+    //param comms Initialized channel (must outlive the replayer)
+
+    explicit PcapReplay(FastComms& comms);
+    ~PcapReplay();
+
+    PcapReplay(const PcapReplay&) = delete;
+    PcapReplay& operator=(const PcapReplay&) = delete;
+
+    //Map and index a capture file (pcap with us/ns timestamps, or pcapng)
+    //param path Capture file
+    //return false if the file cannot be read or is not Ethernet
+
+    bool load(const std::string& path);
+
+    //Reason the last load() failed
+
+    const std::string& error() const { return error_; }
+
+    size_t packet_count() const { return records_.size(); }
+
+    //Time between the first and last frame of the capture
+    //return Seconds
+
+    double capture_duration_s() const;
+
+    //Replay the loaded file until all loops are sent or stop() is called
+    //param config Timing, loops and MAC rewrite
+    //return Totals and timing error
+
+    ReplayReport run(const ReplayConfig& config);
+
+    //Make run() return early (safe from any thread)
+
+    void stop();
+
+private:
+    struct Record {
+        const uint8_t* data;
+        uint32_t length;
+        uint64_t timestamp_ns;
+    };
+
+    FastComms& comms_;
+    const uint8_t* map_;
+    size_t map_size_;
+    std::vector<Record> records_;
+    std::string error_;
+    std::atomic<bool> stop_requested_;
+
+    // Helper methods
+    void unmap();
+    bool parse_pcap();
+    bool parse_pcapng();
+};
+
+} // namespace embedded_test
+
+#endif // PCAP_REPLAY_H
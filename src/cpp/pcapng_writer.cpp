@@ -0,0 +1,367 @@
+/**================================================================================
+* FILE: pcapng_writer.cpp
+
+* Purpose:
+* 1. Implementation of the streaming pcapng capture writer
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "pcapng_writer.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace embedded_test {
+
+// pcapng block types and options (draft-ietf-opsawg-pcapng)
+static const uint32_t kSectionHeaderBlock = 0x0A0D0D0A;
+static const uint32_t kInterfaceDescriptionBlock = 0x00000001;
+static const uint32_t kEnhancedPacketBlock = 0x00000006;
+static const uint32_t kByteOrderMagic = 0x1A2B3C4D;
+static const uint16_t kLinkTypeEthernet = 1;
+static const uint16_t kOptEndOfOpt = 0;
+static const uint16_t kOptShbUserAppl = 4;
+static const uint16_t kOptIfName = 2;
+static const uint16_t kOptIfTsResol = 9;
+static const uint16_t kOptEpbFlags = 2;
+static const uint32_t kEpbInbound = 0x1;
+static const uint32_t kEpbOutbound = 0x2;
+
+// Enhanced packet block without packet data: 28 bytes of header,
+// epb_flags (8), end of options (4) and the trailing length (4)
+static const size_t kEpbOverhead = 44;
+
+static void put16(std::vector<uint8_t>& out, uint16_t value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+static void put32(std::vector<uint8_t>& out, uint32_t value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+static void put_option(std::vector<uint8_t>& out, uint16_t code, const void* data, size_t length) {
+    put16(out, code);
+    put16(out, static_cast<uint16_t>(length));
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + length);
+    out.resize((out.size() + 3) & ~static_cast<size_t>(3), 0);
+}
+
+// Patch the leading and trailing total length of the block started at begin
+static void finish_block(std::vector<uint8_t>& out, size_t begin) {
+    put32(out, 0);
+    uint32_t length = static_cast<uint32_t>(out.size() - begin);
+    memcpy(out.data() + begin + 4, &length, sizeof(length));
+    memcpy(out.data() + out.size() - 4, &length, sizeof(length));
+}
+
+static inline uint8_t* store32(uint8_t* p, uint32_t value) {
+    memcpy(p, &value, sizeof(value));
+    return p + sizeof(value);
+}
+
+PcapngWriter::PcapngWriter()
+    : fill_used_(0),
+      running_(false),
+      stopping_(true),
+      fd_(-1),
+      file_bytes_(0),
+      file_frames_(0),
+      file_index_(0),
+      frames_captured_(0),
+      frames_dropped_(0),
+      frames_written_(0),
+      bytes_written_(0),
+      write_errors_(0),
+      files_opened_(0) {
+}
+
+PcapngWriter::~PcapngWriter() {
+    close();
+}
+
+bool PcapngWriter::open(const CaptureConfig& config, const std::string& interface_name) {
+    close();
+
+    config_ = config;
+    interface_name_ = interface_name;
+    if (config_.snap_length == 0) {
+        config_.snap_length = 65535;
+    }
+    // Room for at least one full-size frame
+    config_.buffer_bytes = std::max(config_.buffer_bytes,
+                                    kEpbOverhead + ((config_.snap_length + 3) & ~3U));
+
+    file_index_ = 0;
+    files_.clear();
+    frames_captured_.store(0);
+    frames_dropped_.store(0);
+    frames_written_.store(0);
+    bytes_written_.store(0);
+    write_errors_.store(0);
+    files_opened_.store(0);
+
+    if (!open_file()) {
+        return false;
+    }
+
+    fill_.assign(config_.buffer_bytes, 0);
+    drain_.assign(config_.buffer_bytes, 0);
+    fill_used_ = 0;
+    stopping_ = false;
+    running_.store(true);
+    writer_ = std::thread(&PcapngWriter::run_writer, this);
+    return true;
+}
+
+void PcapngWriter::close() {
+    if (!running_.load()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+
+    close_file();
+    running_.store(false);
+}
+
+bool PcapngWriter::write(ByteSpan frame, uint64_t timestamp_ns, bool outgoing) {
+    uint32_t captured = static_cast<uint32_t>(std::min<size_t>(frame.size(), config_.snap_length));
+    uint32_t padded = (captured + 3) & ~3U;
+    uint32_t block_length = static_cast<uint32_t>(kEpbOverhead + padded);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+        return false;
+    }
+    if (fill_used_ + block_length > fill_.size()) {
+        frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        wake_.notify_one();
+        return false;
+    }
+
+    uint8_t* p = fill_.data() + fill_used_;
+    p = store32(p, kEnhancedPacketBlock);
+    p = store32(p, block_length);
+    p = store32(p, 0);      // interface id
+    p = store32(p, static_cast<uint32_t>(timestamp_ns >> 32));
+    p = store32(p, static_cast<uint32_t>(timestamp_ns));
+    p = store32(p, captured);
+    p = store32(p, static_cast<uint32_t>(frame.size()));
+    memcpy(p, frame.data(), captured);
+    memset(p + captured, 0, padded - captured);
+    p += padded;
+
+    uint16_t option[2] = {kOptEpbFlags, 4};
+    memcpy(p, option, sizeof(option));
+    p = store32(p + sizeof(option), outgoing ? kEpbOutbound : kEpbInbound);
+    memset(p, 0, 4);        // end of options
+    p = store32(p + 4, block_length);
+
+    fill_used_ += block_length;
+    frames_captured_.fetch_add(1, std::memory_order_relaxed);
+
+    // Start writing well before the buffer fills up
+    if (fill_used_ >= fill_.size() / 2) {
+        wake_.notify_one();
+    }
+    return true;
+}
+
+CaptureStats PcapngWriter::get_statistics() const {
+    CaptureStats stats;
+    stats.frames_captured = frames_captured_.load(std::memory_order_relaxed);
+    stats.frames_dropped = frames_dropped_.load(std::memory_order_relaxed);
+    stats.frames_written = frames_written_.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    stats.files = files_opened_.load(std::memory_order_relaxed);
+    stats.write_errors = write_errors_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string PcapngWriter::current_file() const {
+    std::lock_guard<std::mutex> lock(files_mutex_);
+    return files_.empty() ? std::string() : files_.back();
+}
+
+// Private helper methods
+
+void PcapngWriter::run_writer() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::chrono::milliseconds interval(std::max<uint32_t>(config_.flush_interval_ms, 1));
+
+    for (;;) {
+        wake_.wait_for(lock, interval, [this]() {
+            return stopping_ || fill_used_ >= fill_.size() / 2;
+        });
+
+        if (fill_used_ == 0) {
+            if (stopping_) {
+                break;
+            }
+            continue;
+        }
+
+        // Callers go on filling the other buffer while this one is written
+        fill_.swap(drain_);
+        size_t length = fill_used_;
+        fill_used_ = 0;
+
+        lock.unlock();
+        write_blocks(drain_.data(), length);
+        lock.lock();
+    }
+}
+
+void PcapngWriter::write_blocks(const uint8_t* data, size_t length) {
+    size_t run_start = 0;
+    uint64_t run_frames = 0;
+    size_t offset = 0;
+
+    while (offset < length) {
+        uint32_t block_length;
+        memcpy(&block_length, data + offset + 4, sizeof(block_length));
+
+        // Rotate on a block boundary; every file holds at least one frame
+        uint64_t pending = offset - run_start;
+        if (config_.max_file_bytes > 0 && file_frames_ + run_frames > 0 &&
+            file_bytes_ + pending + block_length > config_.max_file_bytes) {
+            if (write_all(data + run_start, pending)) {
+                file_frames_ += run_frames;
+                frames_written_.fetch_add(run_frames, std::memory_order_relaxed);
+            }
+            close_file();
+            file_index_++;
+            open_file();
+            run_start = offset;
+            run_frames = 0;
+        }
+
+        offset += block_length;
+        run_frames++;
+    }
+
+    if (write_all(data + run_start, length - run_start)) {
+        file_frames_ += run_frames;
+        frames_written_.fetch_add(run_frames, std::memory_order_relaxed);
+    }
+}
+
+bool PcapngWriter::open_file() {
+    std::string name = file_name(file_index_);
+    fd_ = ::open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "Failed to create capture file " << name << ": "
+                  << strerror(errno) << std::endl;
+        write_errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    file_bytes_ = 0;
+    file_frames_ = 0;
+    files_opened_.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(files_mutex_);
+        files_.push_back(name);
+        if (config_.max_files > 0 && files_.size() > config_.max_files) {
+            unlink(files_.front().c_str());
+            files_.pop_front();
+        }
+    }
+
+    // Section header and the one interface every frame refers to
+    std::vector<uint8_t> header;
+
+    put32(header, kSectionHeaderBlock);
+    put32(header, 0);
+    put32(header, kByteOrderMagic);
+    put16(header, 1);
+    put16(header, 0);
+    put32(header, 0xFFFFFFFF);      // section length unknown (-1)
+    put32(header, 0xFFFFFFFF);
+    const char application[] = "testFrameWork fast_comms";
+    put_option(header, kOptShbUserAppl, application, sizeof(application) - 1);
+    put_option(header, kOptEndOfOpt, nullptr, 0);
+    finish_block(header, 0);
+
+    size_t idb = header.size();
+    put32(header, kInterfaceDescriptionBlock);
+    put32(header, 0);
+    put16(header, kLinkTypeEthernet);
+    put16(header, 0);
+    put32(header, config_.snap_length);
+    put_option(header, kOptIfName, interface_name_.data(), interface_name_.size());
+    uint8_t nanoseconds = 9;
+    put_option(header, kOptIfTsResol, &nanoseconds, 1);
+    put_option(header, kOptEndOfOpt, nullptr, 0);
+    finish_block(header, idb);
+
+    return write_all(header.data(), header.size());
+}
+
+void PcapngWriter::close_file() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool PcapngWriter::write_all(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return true;
+    }
+    if (fd_ < 0) {
+        write_errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t done = 0;
+    while (done < length) {
+        ssize_t written = ::write(fd_, data + done, length - done);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Capture write failed: " << strerror(errno) << std::endl;
+            write_errors_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        done += static_cast<size_t>(written);
+    }
+
+    file_bytes_ += length;
+    bytes_written_.fetch_add(length, std::memory_order_relaxed);
+    return true;
+}
+
+std::string PcapngWriter::file_name(uint32_t index) const {
+    if (index == 0) {
+        return config_.path;
+    }
+
+    // capture.pcapng -> capture.3.pcapng
+    size_t slash = config_.path.find_last_of('/');
+    size_t dot = config_.path.find_last_of('.');
+    std::string number = "." + std::to_string(index);
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash) || dot == slash + 1) {
+        return config_.path + number;
+    }
+    return config_.path.substr(0, dot) + number + config_.path.substr(dot);
+}
+
+} // namespace embedded_test
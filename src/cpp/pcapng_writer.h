@@ -0,0 +1,139 @@
+/**================================================================================
+* FILE: pcapng_writer.h
+
+* Purpose:
+* 1. Streaming pcapng capture with nanosecond timestamps
+* 2. Background writer thread, double-buffered, size-based file rotation
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef PCAPNG_WRITER_H
+#define PCAPNG_WRITER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "packet_pool.h"
+
+namespace embedded_test {
+
+//Capture settings
+
+struct CaptureConfig {
+    std::string path;           // first file; rotated files are name.1.pcapng, name.2.pcapng, ...
+    bool transmit;              // also record frames the channel sends
+    uint32_t snap_length;       // bytes kept per frame
+    uint64_t max_file_bytes;    // start a new file past this size, 0 = one file
+    uint32_t max_files;         // delete the oldest file beyond this many, 0 = keep all
+    size_t buffer_bytes;        // size of each of the two write buffers
+    uint32_t flush_interval_ms; // longest time a frame waits in memory
+
+    CaptureConfig() : transmit(false), snap_length(65535), max_file_bytes(0), max_files(0),
+                      buffer_bytes(4 * 1024 * 1024), flush_interval_ms(200) {}
+};
+
+//Capture counters
+
+struct CaptureStats {
+    uint64_t frames_captured;   // frames accepted into the buffer
+    uint64_t frames_dropped;    // frames lost because the writer fell behind
+    uint64_t frames_written;
+    uint64_t bytes_written;     // file bytes, headers included
+    uint32_t files;             // files opened so far
+    uint64_t write_errors;
+
+    CaptureStats() : frames_captured(0), frames_dropped(0), frames_written(0),
+                     bytes_written(0), files(0), write_errors(0) {}
+};
+
+//pcapng file writer
+//Callers append frames to an in-memory buffer under a short lock; a
+//writer thread swaps the buffers and writes the full one to disk in one
+//large write. If both buffers are full the frame is counted as dropped
+//instead of blocking the caller
+
+class PcapngWriter {
+public:
+    PcapngWriter();
+    ~PcapngWriter();
+
+    PcapngWriter(const PcapngWriter&) = delete;
+    PcapngWriter& operator=(const PcapngWriter&) = delete;
+
+    //Create the first file and start the writer thread
+    //param config Path, rotation and buffering
+    //param interface_name Recorded in the interface description block
+    //return true if the file was created
+
+    bool open(const CaptureConfig& config, const std::string& interface_name);
+
+    //Write everything still buffered and close the file
+
+    void close();
+
+    bool is_open() const { return running_.load(); }
+
+    //Queue one frame (safe from any thread)
+    //param frame Frame bytes (cut to snap_length)
+    //param timestamp_ns Wall-clock time in nanoseconds since the epoch
+    //param outgoing true for a transmitted frame
+    //return false if the frame was dropped
+
+    bool write(ByteSpan frame, uint64_t timestamp_ns, bool outgoing);
+
+    CaptureStats get_statistics() const;
+
+    //Path of the file currently being written
+
+    std::string current_file() const;
+
+private:
+    CaptureConfig config_;
+    std::string interface_name_;
+
+    // Buffer being filled by callers and the one being written
+    std::vector<uint8_t> fill_;
+    size_t fill_used_;
+    std::vector<uint8_t> drain_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread writer_;
+    std::atomic<bool> running_;
+    bool stopping_;
+
+    // Owned by the writer thread
+    int fd_;
+    uint64_t file_bytes_;
+    uint64_t file_frames_;
+    uint32_t file_index_;
+    std::deque<std::string> files_;
+    mutable std::mutex files_mutex_;
+
+    std::atomic<uint64_t> frames_captured_;
+    std::atomic<uint64_t> frames_dropped_;
+    std::atomic<uint64_t> frames_written_;
+    std::atomic<uint64_t> bytes_written_;
+    std::atomic<uint64_t> write_errors_;
+    std::atomic<uint32_t> files_opened_;
+
+    // Helper methods
+    void run_writer();
+    void write_blocks(const uint8_t* data, size_t length);
+    bool open_file();
+    void close_file();
+    bool write_all(const uint8_t* data, size_t length);
+    std::string file_name(uint32_t index) const;
+};
+
+} // namespace embedded_test
+
+#endif // PCAPNG_WRITER_H
@@ -0,0 +1,275 @@
+/**================================================================================
+* FILE: traffic_generator.cpp
+
+* Purpose:
+* 1. Implementation of the paced traffic generator
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "traffic_generator.h"
+#include <sys/prctl.h>
+#include <time.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace embedded_test {
+
+// Frames handed to the kernel per send call when several are due
+static const size_t kMaxBurst = 64;
+
+// Re-check interval while the profile asks for zero rate
+static const double kIdleStepNs = 100000.0;
+
+static const uint64_t kDefaultSpinThresholdNs = 50000;
+static const uint64_t kDefaultMaxLagNs = 1000000;
+
+uint64_t monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+void wait_until(uint64_t target_ns, uint64_t spin_threshold_ns) {
+    uint64_t now = monotonic_ns();
+    if (target_ns > now + spin_threshold_ns) {
+        uint64_t wake = target_ns - spin_threshold_ns;
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(wake / 1000000000ULL);
+        ts.tv_nsec = static_cast<long>(wake % 1000000000ULL);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+    }
+
+    while (monotonic_ns() < target_ns) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+TrafficGenerator::TrafficGenerator(FastComms& comms)
+    : comms_(comms),
+      frames_(1, std::vector<uint8_t>(64, 0xAA)),
+      sequence_offset_(-1),
+      spin_threshold_ns_(kDefaultSpinThresholdNs),
+      max_lag_ns_(kDefaultMaxLagNs),
+      stop_requested_(false) {
+}
+
+void TrafficGenerator::set_frames(const std::vector<std::vector<uint8_t>>& frames) {
+    if (!frames.empty()) {
+        frames_ = frames;
+    }
+}
+
+void TrafficGenerator::set_sequence_offset(int offset) {
+    sequence_offset_ = offset;
+}
+
+void TrafficGenerator::set_spin_threshold_us(uint32_t microseconds) {
+    spin_threshold_ns_ = static_cast<uint64_t>(microseconds) * 1000;
+}
+
+void TrafficGenerator::set_max_lag_us(uint32_t microseconds) {
+    max_lag_ns_ = static_cast<uint64_t>(microseconds) * 1000;
+}
+
+TrafficReport TrafficGenerator::run(const TrafficProfile& profile) {
+    TrafficReport report;
+    stop_requested_.store(false);
+
+    uint64_t duration_ns = static_cast<uint64_t>(profile.duration_ms) * 1000000ULL;
+    uint64_t interval_ns = static_cast<uint64_t>(std::max<uint32_t>(profile.interval_ms, 1)) * 1000000ULL;
+    size_t interval_count = std::max<size_t>(1, (duration_ns + interval_ns - 1) / interval_ns);
+
+    std::vector<uint64_t> scheduled(interval_count, 0);
+    std::vector<uint64_t> scheduled_bytes(interval_count, 0);
+    std::vector<uint64_t> sent(interval_count, 0);
+    std::vector<uint64_t> sent_bytes(interval_count, 0);
+    std::vector<uint64_t> errors(interval_count, 0);
+
+    double frame_bits = mean_frame_bits();
+    std::mt19937_64 rng(profile.seed);
+    std::exponential_distribution<double> exponential(1.0);
+
+    // Advances t (ns since start) to the next packet's send time
+    auto next_packet = [&](double& t) {
+        for (;;) {
+            double rate = rate_at(profile, t / 1e9);
+            double pps = profile.rate_in_bps ? rate / frame_bits : rate;
+            if (pps > 0) {
+                double gap = (profile.shape == LoadProfile::POISSON) ? exponential(rng) / pps : 1.0 / pps;
+                t += gap * 1e9;
+            } else {
+                t += kIdleStepNs;
+                if (t < duration_ns) {
+                    continue;
+                }
+            }
+            return t < duration_ns;
+        }
+    };
+
+    // Sequence numbers need a private copy of each frame in the burst
+    size_t max_frame = 0;
+    for (const auto& frame : frames_) {
+        max_frame = std::max(max_frame, frame.size());
+    }
+    bool stamp = sequence_offset_ >= 0;
+    std::vector<uint8_t> scratch(stamp ? kMaxBurst * max_frame : 0);
+    std::vector<ByteSpan> burst;
+    burst.reserve(kMaxBurst);
+    std::vector<uint8_t> accepted;
+
+    size_t frame_index = 0;
+    uint32_t sequence = 0;
+
+    // Fine-grained sleeps need the timer slack off for this thread
+    int old_slack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+    prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+
+    double next_ns = 0.0;
+    bool more = (profile.shape == LoadProfile::POISSON) ? next_packet(next_ns) : duration_ns > 0;
+    uint64_t start = monotonic_ns();
+
+    while (more && !stop_requested_.load(std::memory_order_relaxed)) {
+        uint64_t now = monotonic_ns() - start;
+        if (next_ns > now) {
+            wait_until(start + static_cast<uint64_t>(next_ns), spin_threshold_ns_);
+            now = monotonic_ns() - start;
+        }
+
+        // Everything due goes out together; packets that are too late are dropped
+        // from the schedule instead of being bunched into a burst
+        burst.clear();
+        uint64_t burst_bytes = 0;
+        while (more && next_ns <= now && burst.size() < kMaxBurst) {
+            size_t slot = std::min(interval_count - 1, static_cast<size_t>(next_ns / interval_ns));
+            const std::vector<uint8_t>& frame = frames_[frame_index];
+            scheduled[slot]++;
+            scheduled_bytes[slot] += frame.size();
+            report.scheduled++;
+
+            if (now - static_cast<uint64_t>(next_ns) > max_lag_ns_) {
+                report.skipped++;
+            } else if (stamp) {
+                uint8_t* copy = scratch.data() + burst.size() * max_frame;
+                std::copy(frame.begin(), frame.end(), copy);
+                if (static_cast<size_t>(sequence_offset_) + 4 <= frame.size()) {
+                    copy[sequence_offset_] = static_cast<uint8_t>(sequence >> 24);
+                    copy[sequence_offset_ + 1] = static_cast<uint8_t>(sequence >> 16);
+                    copy[sequence_offset_ + 2] = static_cast<uint8_t>(sequence >> 8);
+                    copy[sequence_offset_ + 3] = static_cast<uint8_t>(sequence);
+                }
+                sequence++;
+                burst.push_back(ByteSpan(copy, frame.size()));
+                burst_bytes += frame.size();
+            } else {
+                burst.push_back(ByteSpan(frame));
+                burst_bytes += frame.size();
+            }
+
+            frame_index = (frame_index + 1) % frames_.size();
+            more = next_packet(next_ns);
+        }
+
+        if (burst.empty()) {
+            continue;
+        }
+
+        size_t ok;
+        if (burst.size() == 1) {
+            ok = comms_.send_packet(burst[0]) ? 1 : 0;
+        } else {
+            ok = static_cast<size_t>(std::max(0, comms_.burst_send(burst, accepted)));
+        }
+
+        // Achieved rate is booked at the time the frames actually left
+        uint64_t sent_at = monotonic_ns() - start;
+        size_t slot = std::min(interval_count - 1, static_cast<size_t>(sent_at / interval_ns));
+        sent[slot] += ok;
+        errors[slot] += burst.size() - ok;
+        if (ok == burst.size()) {
+            sent_bytes[slot] += burst_bytes;
+        } else {
+            for (size_t i = 0; i < burst.size(); i++) {
+                if (burst.size() == 1 || accepted[i]) {
+                    sent_bytes[slot] += burst[i].size();
+                }
+            }
+        }
+    }
+
+    uint64_t elapsed = monotonic_ns() - start;
+    prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(old_slack > 0 ? old_slack : 50000), 0, 0, 0);
+
+    report.elapsed_s = elapsed / 1e9;
+    size_t used = std::min(interval_count, static_cast<size_t>(std::min(elapsed, duration_ns) / interval_ns) + 1);
+
+    for (size_t i = 0; i < used; i++) {
+        uint64_t begin = i * interval_ns;
+        uint64_t end = std::min(begin + interval_ns, std::max(duration_ns, begin + 1));
+        double seconds = (end - begin) / 1e9;
+
+        IntervalReport interval;
+        interval.start_s = begin / 1e9;
+        interval.requested_pps = scheduled[i] / seconds;
+        interval.achieved_pps = sent[i] / seconds;
+        interval.requested_bps = scheduled_bytes[i] * 8.0 / seconds;
+        interval.achieved_bps = sent_bytes[i] * 8.0 / seconds;
+        interval.packets = sent[i];
+        interval.errors = errors[i];
+        report.intervals.push_back(interval);
+
+        report.totals.packets_sent += sent[i];
+        report.totals.bytes_sent += sent_bytes[i];
+        report.totals.errors += errors[i];
+    }
+
+    return report;
+}
+
+void TrafficGenerator::stop() {
+    stop_requested_.store(true);
+}
+
+// Private helper methods
+
+double TrafficGenerator::rate_at(const TrafficProfile& profile, double t) const {
+    switch (profile.shape) {
+    case LoadProfile::STEP_RAMP: {
+        uint32_t steps = std::max<uint32_t>(profile.steps, 1);
+        if (steps == 1) {
+            return profile.rate;
+        }
+        double step_length = profile.duration_ms / 1000.0 / steps;
+        uint32_t step = std::min<uint32_t>(steps - 1, static_cast<uint32_t>(t / step_length));
+        return profile.start_rate + (profile.rate - profile.start_rate) * step / (steps - 1);
+    }
+
+    case LoadProfile::SINE: {
+        double period = std::max<uint32_t>(profile.period_ms, 1) / 1000.0;
+        double rate = profile.rate + profile.amplitude * std::sin(2.0 * M_PI * t / period);
+        return std::max(0.0, rate);
+    }
+
+    case LoadProfile::CONSTANT:
+    case LoadProfile::POISSON:
+    default:
+        return profile.rate;
+    }
+}
+
+double TrafficGenerator::mean_frame_bits() const {
+    double total = 0;
+    for (const auto& frame : frames_) {
+        total += frame.size();
+    }
+    double mean = total / frames_.size();
+    return mean > 0 ? mean * 8.0 : 8.0;
+}
+
+} // namespace embedded_test
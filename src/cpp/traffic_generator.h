@@ -0,0 +1,150 @@
+/**================================================================================
+* FILE: traffic_generator.h
+
+* Purpose:
+* 1. Rate-controlled traffic generation (pps or bps) on a FastComms channel
+* 2. Constant, step-ramp, sine and Poisson load profiles
+* 3. Achieved vs requested rate reported per interval
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef TRAFFIC_GENERATOR_H
+#define TRAFFIC_GENERATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <vector>
+#include "fast_comms.h"
+
+namespace embedded_test {
+
+//Monotonic clock used for pacing
+//return Nanoseconds since an arbitrary start
+
+uint64_t monotonic_ns();
+
+//Sleep until close to target, then spin the rest of the way; sleeping
+//alone overshoots by the timer slack and scheduler latency
+//param target_ns Deadline on the monotonic_ns() clock
+//param spin_threshold_ns Waits shorter than this are spun
+
+void wait_until(uint64_t target_ns, uint64_t spin_threshold_ns);
+
+//Shape of the offered load over time
+
+enum class LoadProfile {
+    CONSTANT,       // rate for the whole run
+    STEP_RAMP,      // steps equal steps from start_rate up (or down) to rate
+    SINE,           // rate + amplitude * sin(2*pi*t / period)
+    POISSON         // exponential inter-arrival times with mean rate
+};
+
+//What to generate; all rates use the same unit (pps, or bps if rate_in_bps)
+
+struct TrafficProfile {
+    LoadProfile shape;
+    double rate;                // target (or final/mean) rate
+    bool rate_in_bps;           // rates are frame bits per second, not packets
+    double start_rate;          // STEP_RAMP: first step
+    uint32_t steps;             // STEP_RAMP: number of steps
+    double amplitude;           // SINE: peak deviation from rate
+    uint32_t period_ms;         // SINE: period
+    uint32_t duration_ms;       // run time
+    uint32_t interval_ms;       // reporting interval
+    uint32_t seed;              // POISSON: random seed
+
+    TrafficProfile() : shape(LoadProfile::CONSTANT), rate(1000.0), rate_in_bps(false),
+                       start_rate(0.0), steps(10), amplitude(0.0), period_ms(1000),
+                       duration_ms(1000), interval_ms(100), seed(1) {}
+};
+
+//Rates measured over one reporting interval
+
+struct IntervalReport {
+    double start_s;             // interval start, seconds into the run
+    double requested_pps;       // packets the profile scheduled
+    double achieved_pps;        // packets the kernel accepted
+    double requested_bps;
+    double achieved_bps;
+    uint64_t packets;
+    uint64_t errors;
+
+    IntervalReport() : start_s(0), requested_pps(0), achieved_pps(0), requested_bps(0),
+                       achieved_bps(0), packets(0), errors(0) {}
+};
+
+//Result of one generator run
+
+struct TrafficReport {
+    std::vector<IntervalReport> intervals;
+    PacketStats totals;
+    uint64_t scheduled;         // packets the profile asked for
+    uint64_t skipped;           // scheduled packets dropped because the sender fell behind
+    double elapsed_s;
+
+    TrafficReport() : scheduled(0), skipped(0), elapsed_s(0) {}
+};
+
+//Paced sender
+//Packets follow an absolute schedule derived from the profile. The thread
+//sleeps until shortly before each send time and spins the rest of the way;
+//packets that are already due go out as one burst. If the sender falls
+//further behind than the allowed lag, the overdue packets are skipped and
+//reported rather than sent late in a burst
+
+class TrafficGenerator {
+public:
+    //param comms Initialized channel (must outlive the generator)
+
+    explicit TrafficGenerator(FastComms& comms);
+
+    //Frames to send, used round-robin (default: one 64-byte 0xAA frame)
+    //param frames Prebuilt frames
+
+    void set_frames(const std::vector<std::vector<uint8_t>>& frames);
+
+    //Write a 32-bit big-endian sequence number into every frame
+    //param offset Byte offset in the frame, -1 to disable
+
+    void set_sequence_offset(int offset);
+
+    //Waits shorter than this are spun instead of slept
+    //param microseconds Spin threshold (default 50)
+
+    void set_spin_threshold_us(uint32_t microseconds);
+
+    //How far the sender may fall behind before packets are skipped
+    //param microseconds Maximum lag (default 1000)
+
+    void set_max_lag_us(uint32_t microseconds);
+
+    //Generate traffic until the profile ends or stop() is called
+    //param profile Load profile
+    //return Per-interval and total rates
+
+    TrafficReport run(const TrafficProfile& profile);
+
+    //Make run() return early (safe from any thread)
+
+    void stop();
+
+private:
+    FastComms& comms_;
+    std::vector<std::vector<uint8_t>> frames_;
+    int sequence_offset_;
+    uint64_t spin_threshold_ns_;
+    uint64_t max_lag_ns_;
+    std::atomic<bool> stop_requested_;
+
+    // Helper methods
+    double rate_at(const TrafficProfile& profile, double t) const;
+    double mean_frame_bits() const;
+};
+
+} // namespace embedded_test
+
+#endif // TRAFFIC_GENERATOR_H
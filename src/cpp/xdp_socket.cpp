@@ -0,0 +1,509 @@
+/**================================================================================
+* FILE: xdp_socket.cpp
+
+* Purpose:
+* 1. Implementation of the AF_XDP transport
+* 2. Loads a minimal XSKMAP redirect program with raw bpf() syscalls so no
+*    libbpf/libxdp dependency is needed
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#include "xdp_socket.h"
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <net/if.h>
+#include <linux/if_xdp.h>
+#include <linux/if_link.h>
+#include <linux/bpf.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+
+#ifndef AF_XDP
+#define AF_XDP 44
+#endif
+
+namespace embedded_test {
+
+// Time to wait for the kernel to complete TX frames when UMEM runs dry
+static const int kTxReclaimWaitMs = 10;
+
+static int bpf_call(int cmd, union bpf_attr* attr) {
+    return static_cast<int>(syscall(__NR_bpf, cmd, attr, sizeof(*attr)));
+}
+
+static uint64_t realtime_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+XdpSocket::XdpSocket()
+    : fd_(-1),
+      prog_fd_(-1),
+      map_fd_(-1),
+      link_fd_(-1),
+      zero_copy_(false),
+      need_wakeup_(false),
+      umem_(nullptr),
+      umem_size_(0),
+      frame_size_(0),
+      held_frame_(0),
+      holding_(false),
+      reported_drops_(0) {
+}
+
+XdpSocket::~XdpSocket() {
+    close();
+}
+
+bool XdpSocket::open(const std::string& interface_name, const XdpConfig& config,
+                     bool tx, bool rx) {
+    close();
+
+    int ifindex = static_cast<int>(if_nametoindex(interface_name.c_str()));
+    if (ifindex == 0) {
+        std::cerr << "AF_XDP: unknown interface " << interface_name << std::endl;
+        return false;
+    }
+
+    fd_ = socket(AF_XDP, SOCK_RAW, 0);
+    if (fd_ < 0) {
+        std::cerr << "AF_XDP: socket not supported: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // UMEM: one contiguous, page-aligned area carved into equal chunks
+    frame_size_ = config.frame_size;
+    umem_size_ = static_cast<size_t>(config.frame_count) * config.frame_size;
+    void* area = mmap(nullptr, umem_size_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (area == MAP_FAILED) {
+        std::cerr << "AF_XDP: failed to allocate UMEM" << std::endl;
+        umem_size_ = 0;
+        close();
+        return false;
+    }
+    umem_ = static_cast<uint8_t*>(area);
+
+    struct xdp_umem_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.addr = reinterpret_cast<uint64_t>(umem_);
+    reg.len = umem_size_;
+    reg.chunk_size = config.frame_size;
+    reg.headroom = 0;
+
+    if (setsockopt(fd_, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) < 0) {
+        std::cerr << "AF_XDP: UMEM registration failed: " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    // Fill and completion rings are required even for one-way sockets
+    int umem_ring = static_cast<int>(config.frame_count);
+    int desc_ring = static_cast<int>(config.ring_size);
+    if (setsockopt(fd_, SOL_XDP, XDP_UMEM_FILL_RING, &umem_ring, sizeof(umem_ring)) < 0 ||
+        setsockopt(fd_, SOL_XDP, XDP_UMEM_COMPLETION_RING, &umem_ring, sizeof(umem_ring)) < 0 ||
+        (rx && setsockopt(fd_, SOL_XDP, XDP_RX_RING, &desc_ring, sizeof(desc_ring)) < 0) ||
+        (tx && setsockopt(fd_, SOL_XDP, XDP_TX_RING, &desc_ring, sizeof(desc_ring)) < 0)) {
+        std::cerr << "AF_XDP: ring setup failed: " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    struct xdp_mmap_offsets off;
+    socklen_t optlen = sizeof(off);
+    if (getsockopt(fd_, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen) < 0) {
+        std::cerr << "AF_XDP: failed to read ring offsets" << std::endl;
+        close();
+        return false;
+    }
+
+    if (!map_ring(fill_, XDP_UMEM_PGOFF_FILL_RING, off.fr, config.frame_count, sizeof(uint64_t)) ||
+        !map_ring(completion_, XDP_UMEM_PGOFF_COMPLETION_RING, off.cr,
+                  config.frame_count, sizeof(uint64_t)) ||
+        (rx && !map_ring(rx_, XDP_PGOFF_RX_RING, off.rx, config.ring_size,
+                         sizeof(struct xdp_desc))) ||
+        (tx && !map_ring(tx_, XDP_PGOFF_TX_RING, off.tx, config.ring_size,
+                         sizeof(struct xdp_desc)))) {
+        std::cerr << "AF_XDP: failed to map rings" << std::endl;
+        close();
+        return false;
+    }
+
+    if (!bind_socket(ifindex, config)) {
+        close();
+        return false;
+    }
+
+    // Split UMEM between the fill ring (RX) and the TX free list
+    free_frames_.clear();
+    free_frames_.reserve(config.frame_count);
+    for (uint32_t i = 0; i < config.frame_count; i++) {
+        free_frames_.push_back(static_cast<uint64_t>(i) * config.frame_size);
+    }
+    if (rx) {
+        refill(tx ? config.frame_count / 2 : config.frame_count);
+    }
+
+    if (rx && !attach_program(ifindex, config)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void XdpSocket::close() {
+    // Closing the link detaches the program from the interface
+    if (link_fd_ >= 0) {
+        ::close(link_fd_);
+        link_fd_ = -1;
+    }
+    if (prog_fd_ >= 0) {
+        ::close(prog_fd_);
+        prog_fd_ = -1;
+    }
+    if (map_fd_ >= 0) {
+        ::close(map_fd_);
+        map_fd_ = -1;
+    }
+
+    unmap_ring(fill_);
+    unmap_ring(completion_);
+    unmap_ring(rx_);
+    unmap_ring(tx_);
+
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    if (umem_ != nullptr) {
+        munmap(umem_, umem_size_);
+        umem_ = nullptr;
+    }
+
+    umem_size_ = 0;
+    zero_copy_ = false;
+    need_wakeup_ = false;
+    free_frames_.clear();
+    holding_ = false;
+    reported_drops_ = 0;
+}
+
+bool XdpSocket::send(const uint8_t* data, size_t len) {
+    if (tx_.descs == nullptr || len == 0 || len > frame_size_) {
+        return false;
+    }
+
+    uint32_t consumer = __atomic_load_n(tx_.consumer, __ATOMIC_ACQUIRE);
+    bool ring_full = (tx_.cached_prod - consumer) >= tx_.size;
+
+    if (free_frames_.empty() || ring_full) {
+        reclaim_completions();
+        if (free_frames_.empty() || ring_full) {
+            // Push out what is queued and give the kernel a moment to finish
+            kick();
+            struct pollfd pfd;
+            pfd.fd = fd_;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            poll(&pfd, 1, kTxReclaimWaitMs);
+            reclaim_completions();
+
+            consumer = __atomic_load_n(tx_.consumer, __ATOMIC_ACQUIRE);
+            if (free_frames_.empty() || (tx_.cached_prod - consumer) >= tx_.size) {
+                return false;
+            }
+        }
+    }
+
+    uint64_t addr = free_frames_.back();
+    free_frames_.pop_back();
+    memcpy(umem_ + addr, data, len);
+
+    struct xdp_desc* descs = static_cast<struct xdp_desc*>(tx_.descs);
+    struct xdp_desc& desc = descs[tx_.cached_prod & (tx_.size - 1)];
+    desc.addr = addr;
+    desc.len = static_cast<uint32_t>(len);
+    desc.options = 0;
+
+    tx_.cached_prod++;
+    __atomic_store_n(tx_.producer, tx_.cached_prod, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+int XdpSocket::kick() {
+    if (tx_.descs == nullptr) {
+        return -1;
+    }
+
+    bool wake = !need_wakeup_ ||
+                (__atomic_load_n(tx_.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP);
+
+    // Copy mode transmits a limited batch per wakeup and returns EAGAIN
+    // while descriptors remain, so keep kicking as long as it makes progress
+    while (wake) {
+        uint32_t before = __atomic_load_n(tx_.consumer, __ATOMIC_ACQUIRE);
+        if (sendto(fd_, nullptr, 0, MSG_DONTWAIT, nullptr, 0) >= 0) {
+            break;
+        }
+
+        uint32_t after = __atomic_load_n(tx_.consumer, __ATOMIC_ACQUIRE);
+        if (errno == EAGAIN && after != before && after != tx_.cached_prod) {
+            continue;
+        }
+
+        // The kernel is still busy with an earlier kick; frames stay queued
+        if (errno != EAGAIN && errno != EBUSY && errno != ENOBUFS && errno != ENETDOWN) {
+            return -1;
+        }
+        break;
+    }
+
+    reclaim_completions();
+    return 0;
+}
+
+bool XdpSocket::receive(PacketView& view) {
+    if (rx_.descs == nullptr) {
+        return false;
+    }
+
+    // The caller is done with the previous frame; give it back to the kernel
+    if (holding_) {
+        free_frames_.push_back(held_frame_);
+        refill(1);
+        holding_ = false;
+    }
+
+    uint32_t producer = __atomic_load_n(rx_.producer, __ATOMIC_ACQUIRE);
+    if (rx_.cached_cons == producer) {
+        if (need_wakeup_ && (__atomic_load_n(fill_.flags, __ATOMIC_ACQUIRE) & XDP_RING_NEED_WAKEUP)) {
+            recvfrom(fd_, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+        }
+        return false;
+    }
+
+    const struct xdp_desc* descs = static_cast<const struct xdp_desc*>(rx_.descs);
+    struct xdp_desc desc = descs[rx_.cached_cons & (rx_.size - 1)];
+    rx_.cached_cons++;
+    __atomic_store_n(rx_.consumer, rx_.cached_cons, __ATOMIC_RELEASE);
+
+    held_frame_ = desc.addr - (desc.addr % frame_size_);
+    holding_ = true;
+
+    view.data = umem_ + desc.addr;
+    view.length = desc.len;
+    view.timestamp_ns = realtime_ns();
+    view.outgoing = false;
+    view.hardware_timestamp = false;
+
+    return true;
+}
+
+uint64_t XdpSocket::take_drops() const {
+    if (fd_ < 0) {
+        return 0;
+    }
+
+    struct xdp_statistics stats;
+    memset(&stats, 0, sizeof(stats));
+    socklen_t optlen = sizeof(stats);
+    if (getsockopt(fd_, SOL_XDP, XDP_STATISTICS, &stats, &optlen) < 0) {
+        return 0;
+    }
+
+    // Unlike PACKET_STATISTICS these counters are cumulative
+    uint64_t total = stats.rx_dropped + stats.rx_ring_full;
+    uint64_t delta = total - reported_drops_;
+    reported_drops_ = total;
+    return delta;
+}
+
+// Private helper methods
+
+bool XdpSocket::map_ring(XdpRing& ring, uint64_t pgoff, const struct xdp_ring_offset& off,
+                         uint32_t entries, size_t desc_size) {
+    size_t map_size = off.desc + entries * desc_size;
+    void* map = mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd_, static_cast<off_t>(pgoff));
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    uint8_t* base = static_cast<uint8_t*>(map);
+    ring.map = map;
+    ring.map_size = map_size;
+    ring.producer = reinterpret_cast<uint32_t*>(base + off.producer);
+    ring.consumer = reinterpret_cast<uint32_t*>(base + off.consumer);
+    ring.flags = reinterpret_cast<uint32_t*>(base + off.flags);
+    ring.descs = base + off.desc;
+    ring.size = entries;
+    ring.cached_prod = *ring.producer;
+    ring.cached_cons = *ring.consumer;
+
+    return true;
+}
+
+void XdpSocket::unmap_ring(XdpRing& ring) {
+    if (ring.map != nullptr) {
+        munmap(ring.map, ring.map_size);
+    }
+    ring = XdpRing();
+}
+
+bool XdpSocket::bind_socket(int ifindex, const XdpConfig& config) {
+    struct sockaddr_xdp sxdp;
+    memset(&sxdp, 0, sizeof(sxdp));
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = static_cast<uint32_t>(ifindex);
+    sxdp.sxdp_queue_id = config.queue_id;
+
+    // Zero-copy needs driver support; copy mode works everywhere, and
+    // need_wakeup is missing on kernels older than 5.4
+    const uint16_t attempts[] = {
+        XDP_ZEROCOPY | XDP_USE_NEED_WAKEUP,
+        XDP_COPY | XDP_USE_NEED_WAKEUP,
+        XDP_COPY,
+    };
+
+    for (uint16_t flags : attempts) {
+        if ((flags & XDP_ZEROCOPY) && (!config.zero_copy || config.generic_only)) {
+            continue;
+        }
+
+        sxdp.sxdp_flags = flags;
+        if (bind(fd_, reinterpret_cast<struct sockaddr*>(&sxdp), sizeof(sxdp)) == 0) {
+            zero_copy_ = (flags & XDP_ZEROCOPY) != 0;
+            need_wakeup_ = (flags & XDP_USE_NEED_WAKEUP) != 0;
+            return true;
+        }
+    }
+
+    std::cerr << "AF_XDP: bind failed: " << strerror(errno) << std::endl;
+    return false;
+}
+
+bool XdpSocket::attach_program(int ifindex, const XdpConfig& config) {
+    union bpf_attr attr;
+
+    // XSKMAP indexed by RX queue; our socket sits at config.queue_id
+    memset(&attr, 0, sizeof(attr));
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof(uint32_t);
+    attr.value_size = sizeof(uint32_t);
+    attr.max_entries = config.queue_id + 1;
+    map_fd_ = bpf_call(BPF_MAP_CREATE, &attr);
+    if (map_fd_ < 0) {
+        std::cerr << "AF_XDP: failed to create XSKMAP: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // return bpf_redirect_map(&xsks, ctx->rx_queue_index, XDP_PASS);
+    struct bpf_insn prog[6];
+    memset(prog, 0, sizeof(prog));
+    prog[0].code = BPF_LDX | BPF_MEM | BPF_W;
+    prog[0].dst_reg = BPF_REG_2;
+    prog[0].src_reg = BPF_REG_1;
+    prog[0].off = offsetof(struct xdp_md, rx_queue_index);
+    prog[1].code = BPF_LD | BPF_DW | BPF_IMM;
+    prog[1].dst_reg = BPF_REG_1;
+    prog[1].src_reg = BPF_PSEUDO_MAP_FD;
+    prog[1].imm = map_fd_;
+    prog[3].code = BPF_ALU64 | BPF_MOV | BPF_K;
+    prog[3].dst_reg = BPF_REG_3;
+    prog[3].imm = XDP_PASS;
+    prog[4].code = BPF_JMP | BPF_CALL;
+    prog[4].imm = BPF_FUNC_redirect_map;
+    prog[5].code = BPF_JMP | BPF_EXIT;
+
+    static const char license[] = "GPL";
+    memset(&attr, 0, sizeof(attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insns = reinterpret_cast<uint64_t>(prog);
+    attr.insn_cnt = sizeof(prog) / sizeof(prog[0]);
+    attr.license = reinterpret_cast<uint64_t>(license);
+    prog_fd_ = bpf_call(BPF_PROG_LOAD, &attr);
+    if (prog_fd_ < 0) {
+        std::cerr << "AF_XDP: failed to load XDP program: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    uint32_t key = config.queue_id;
+    uint32_t value = static_cast<uint32_t>(fd_);
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = static_cast<uint32_t>(map_fd_);
+    attr.key = reinterpret_cast<uint64_t>(&key);
+    attr.value = reinterpret_cast<uint64_t>(&value);
+    attr.flags = BPF_ANY;
+    if (bpf_call(BPF_MAP_UPDATE_ELEM, &attr) < 0) {
+        std::cerr << "AF_XDP: failed to register socket in XSKMAP: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Prefer native XDP; generic mode works on any interface, including veth
+    const uint32_t modes[] = { XDP_FLAGS_DRV_MODE, XDP_FLAGS_SKB_MODE };
+
+    for (uint32_t mode : modes) {
+        if (mode == XDP_FLAGS_DRV_MODE && config.generic_only) {
+            continue;
+        }
+
+        memset(&attr, 0, sizeof(attr));
+        attr.link_create.prog_fd = static_cast<uint32_t>(prog_fd_);
+        attr.link_create.target_ifindex = static_cast<uint32_t>(ifindex);
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags = mode;
+        link_fd_ = bpf_call(BPF_LINK_CREATE, &attr);
+        if (link_fd_ >= 0) {
+            return true;
+        }
+    }
+
+    std::cerr << "AF_XDP: failed to attach XDP program: " << strerror(errno) << std::endl;
+    return false;
+}
+
+void XdpSocket::refill(uint32_t count) {
+    uint32_t consumer = __atomic_load_n(fill_.consumer, __ATOMIC_ACQUIRE);
+    uint64_t* addrs = static_cast<uint64_t*>(fill_.descs);
+
+    while (count > 0 && !free_frames_.empty() &&
+           (fill_.cached_prod - consumer) < fill_.size) {
+        addrs[fill_.cached_prod & (fill_.size - 1)] = free_frames_.back();
+        free_frames_.pop_back();
+        fill_.cached_prod++;
+        count--;
+    }
+
+    __atomic_store_n(fill_.producer, fill_.cached_prod, __ATOMIC_RELEASE);
+}
+
+void XdpSocket::reclaim_completions() {
+    uint32_t producer = __atomic_load_n(completion_.producer, __ATOMIC_ACQUIRE);
+    const uint64_t* addrs = static_cast<const uint64_t*>(completion_.descs);
+
+    while (completion_.cached_cons != producer) {
+        free_frames_.push_back(addrs[completion_.cached_cons & (completion_.size - 1)]);
+        completion_.cached_cons++;
+    }
+
+    __atomic_store_n(completion_.consumer, completion_.cached_cons, __ATOMIC_RELEASE);
+}
+
+} // namespace embedded_test
@@ -0,0 +1,150 @@
+/**================================================================================
+* FILE: xdp_socket.h
+
+* Purpose:
+* 1. AF_XDP transport for line-rate DUT traffic (UMEM, fill/completion rings)
+
+* Author: Diksha Ravindran
+* Year: Oct - 2026
+* version: Not completed yet - Draft
+================================================================================
+*/
+#ifndef XDP_SOCKET_H
+#define XDP_SOCKET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "packet_ring.h"
+
+struct xdp_ring_offset;
+
+namespace embedded_test {
+
+//AF_XDP socket settings
+//frame_count and ring_size must be powers of two
+
+struct XdpConfig {
+    uint32_t queue_id;      // NIC queue to bind (RX frames on other queues are not seen)
+    uint32_t frame_size;    // UMEM chunk size, 2048 or 4096
+    uint32_t frame_count;   // UMEM chunks shared by RX and TX
+    uint32_t ring_size;     // RX/TX descriptor ring entries
+    bool zero_copy;         // try zero-copy before falling back to copy mode
+    bool generic_only;      // skip native XDP and attach in generic (SKB) mode
+
+    XdpConfig() : queue_id(0), frame_size(2048), frame_count(4096),
+                  ring_size(2048), zero_copy(true), generic_only(false) {}
+};
+
+//Single-producer/single-consumer ring shared with the kernel
+
+struct XdpRing {
+    uint32_t* producer;
+    uint32_t* consumer;
+    uint32_t* flags;
+    void* descs;
+    uint32_t size;
+    uint32_t cached_prod;
+    uint32_t cached_cons;
+    void* map;
+    size_t map_size;
+
+    XdpRing() : producer(nullptr), consumer(nullptr), flags(nullptr),
+                descs(nullptr), size(0), cached_prod(0), cached_cons(0),
+                map(nullptr), map_size(0) {}
+};
+
+//AF_XDP socket bound to one NIC queue
+//Frames live in a UMEM area shared with the kernel. RX frames are read in
+//place and returned to the fill ring on the next receive; TX frames are
+//copied into free UMEM chunks that come back through the completion ring
+
+class XdpSocket {
+public:
+    XdpSocket();
+    ~XdpSocket();
+
+    XdpSocket(const XdpSocket&) = delete;
+    XdpSocket& operator=(const XdpSocket&) = delete;
+
+    //Create the socket, register UMEM and (for RX) attach the redirect program
+    //param interface_name Network interface
+    //param config Socket settings
+    //param tx Enable the TX ring
+    //param rx Enable the RX ring and XDP program
+    //return true if successful
+
+    bool open(const std::string& interface_name, const XdpConfig& config, bool tx, bool rx);
+
+    //Detach the program and release all rings
+
+    void close();
+
+    bool is_open() const { return fd_ >= 0; }
+    int fd() const { return fd_; }
+
+    //return true if bound in zero-copy mode
+
+    bool is_zero_copy() const { return zero_copy_; }
+
+    //Largest frame one UMEM chunk can carry
+
+    size_t max_frame() const { return frame_size_; }
+
+    //Copy one frame into a free UMEM chunk and queue it on the TX ring
+    //Does not wake the kernel; call kick() after a batch
+    //return true if the frame was queued
+
+    bool send(const uint8_t* data, size_t len);
+
+    //Wake the kernel to transmit queued frames
+    //return 0 on success, -1 on error
+
+    int kick();
+
+    //Take the next received frame without copying it
+    //param view Points into UMEM; valid until the next receive call
+    //return true if a frame was available
+
+    bool receive(PacketView& view);
+
+    //Frames dropped by the kernel since the previous call
+
+    uint64_t take_drops() const;
+
+private:
+    int fd_;
+    int prog_fd_;
+    int map_fd_;
+    int link_fd_;
+    bool zero_copy_;
+    bool need_wakeup_;
+
+    uint8_t* umem_;
+    size_t umem_size_;
+    uint32_t frame_size_;
+
+    XdpRing fill_;
+    XdpRing completion_;
+    XdpRing rx_;
+    XdpRing tx_;
+
+    std::vector<uint64_t> free_frames_;
+    uint64_t held_frame_;
+    bool holding_;
+    mutable uint64_t reported_drops_;
+
+    // Helper methods
+    bool map_ring(XdpRing& ring, uint64_t pgoff, const struct xdp_ring_offset& off,
+                  uint32_t entries, size_t desc_size);
+    void unmap_ring(XdpRing& ring);
+    bool bind_socket(int ifindex, const XdpConfig& config);
+    bool attach_program(int ifindex, const XdpConfig& config);
+    void refill(uint32_t count);
+    void reclaim_completions();
+};
+
+} // namespace embedded_test
+
+#endif // XDP_SOCKET_H
@@ -15,10 +15,21 @@ import socket
 import time
 import logging
 import re
+from collections import deque
 from typing import Optional, Tuple, List, Dict
 from dataclasses import dataclass
 from enum import Enum
 
+# Checksums and AA55 framing run in the C++ extension when it is built
+try:
+    from fast_comms_cpp import PacketValidator as _FastValidator
+    from fast_comms_cpp import Aa55Codec as _FastCodec
+    from fast_comms_cpp import Aa55Framer as _FastFramer
+except ImportError:
+    _FastValidator = None
+    _FastCodec = None
+    _FastFramer = None
+
 
 logger = logging.getLogger(__name__)
 
@@ -54,6 +65,8 @@ class DUTConnection:
         self.cli_socket = None
         self.connected = False
         self.cli_authenticated = False
+        self._framer = None
+        self._frames = deque()
         
     def connect(self) -> bool:
         """
@@ -102,6 +115,8 @@ class DUTConnection:
             
         self.connected = False
         self.cli_authenticated = False
+        self._framer = None
+        self._frames.clear()
     
     def send(self, data: bytes) -> bool:
         """
@@ -146,6 +161,47 @@ class DUTConnection:
             logger.error(f"Receive failed: {e}")
             return None
     
+    def receive_frame(self, buffer_size: int = 65536) -> Optional[bytes]:
+        """
+        Receive one complete AA55 frame
+        
+        TCP delivers a byte stream, so one recv() may hold part of a frame
+        or several frames. Chunks are fed to a stream framer and whole frames
+        are returned one per call; noise and frames with a bad checksum are
+        skipped up to the next 0xAA55 marker.
+        
+        Returns:
+            Frame bytes (header to checksum) or None on timeout/error/close
+        """
+        if self._framer is None:
+            self._framer = _FastFramer() if _FastFramer is not None else StreamFramer()
+        
+        while not self._frames:
+            data = self.receive(buffer_size)
+            if not data:
+                return None
+            self._frames.extend(self._framer.push(data))
+        
+        return self._frames.popleft()
+    
+    def get_framer_statistics(self) -> Dict[str, int]:
+        """
+        Get stream framer counters (frames, bytes_in, garbage_bytes,
+        resyncs, checksum_failures) since connect
+        """
+        if self._framer is None:
+            return {}
+        stats = self._framer.get_statistics()
+        if isinstance(stats, dict):
+            return stats
+        return {
+            'frames': stats.frames,
+            'bytes_in': stats.bytes_in,
+            'garbage_bytes': stats.garbage_bytes,
+            'resyncs': stats.resyncs,
+            'checksum_failures': stats.checksum_failures
+        }
+    
     def send_and_receive(
         self, 
         data: bytes, 
@@ -408,6 +464,13 @@ class PacketBuilder:
         [START_MARKER][COMMAND][SEQ_NUM][LENGTH][PAYLOAD][CHECKSUM]
         2 bytes       1 byte    2 bytes  2 bytes variable 2 bytes
         """
+        # Values struct.pack would reject take the Python path so the error is unchanged
+        if (_FastCodec is not None and isinstance(payload, bytes)
+                and isinstance(command, int) and 0 <= command <= 0xFF
+                and isinstance(sequence_num, int) and 0 <= sequence_num <= 0xFFFF
+                and len(payload) <= 0xFFFF):
+            return _FastCodec.build(command, payload, sequence_num, bool(include_checksum))
+        
         import struct
         
         START_MARKER = 0xAA55
@@ -431,6 +494,9 @@ class PacketBuilder:
         Returns:
             Dictionary with packet fields or None if invalid
         """
+        if _FastCodec is not None and isinstance(data, bytes):
+            return _FastCodec.parse(data)
+        
         import struct
         
         if len(data) < 9:  # Minimum packet size
@@ -468,6 +534,9 @@ class PacketBuilder:
     @staticmethod
     def calculate_checksum(data: bytes) -> int:
         """Calculate simple 16-bit checksum"""
+        if _FastValidator is not None:
+            return _FastValidator.calculate_simple_checksum(data)
+        
         checksum = 0
         for i in range(0, len(data), 2):
             if i + 1 < len(data):
@@ -483,6 +552,97 @@ class PacketBuilder:
         return (~checksum) & 0xFFFF
 
 
+class StreamFramer:
+    """
+    Incremental AA55 framer for TCP streams
+    Python stand-in for fast_comms_cpp.Aa55Framer when the extension is not built
+    """
+    
+    MARKER = b'\xaa\x55'
+    
+    def __init__(self):
+        self.reset()
+    
+    def reset(self):
+        """Drop any partial frame and clear the counters"""
+        self.buffer = bytearray()
+        self.frames = 0
+        self.bytes_in = 0
+        self.garbage_bytes = 0
+        self.resyncs = 0
+        self.checksum_failures = 0
+        self._in_sync = True
+    
+    @property
+    def buffered(self) -> int:
+        """Bytes held for a frame that is not complete yet"""
+        return len(self.buffer)
+    
+    def push(self, chunk: bytes) -> List[bytes]:
+        """
+        Feed the next chunk of the stream
+        
+        Returns:
+            Complete frames, in stream order
+        """
+        self.bytes_in += len(chunk)
+        buf = self.buffer
+        buf += chunk
+        frames = []
+        pos = 0
+        
+        while True:
+            start = buf.find(self.MARKER, pos)
+            if start < 0:
+                # A trailing 0xAA may be the first half of the next marker
+                start = len(buf) - 1 if buf.endswith(b'\xaa') and len(buf) > pos else len(buf)
+                self._discard(start - pos)
+                pos = start
+                break
+            self._discard(start - pos)
+            pos = start
+            
+            if len(buf) - pos < 7:
+                break
+            end = pos + 7 + ((buf[pos + 5] << 8) | buf[pos + 6]) + 2
+            if end > len(buf):
+                break
+            
+            frame = bytes(buf[pos:end])
+            if PacketBuilder.calculate_checksum(frame[:-2]) != ((frame[-2] << 8) | frame[-1]):
+                # Bad checksum: treat the marker as noise and rescan after it
+                self.checksum_failures += 1
+                self._discard(1)
+                pos += 1
+                continue
+            
+            frames.append(frame)
+            self.frames += 1
+            self._in_sync = True
+            pos = end
+        
+        del buf[:pos]
+        return frames
+    
+    def get_statistics(self) -> Dict[str, int]:
+        """Get frame, garbage and resync counters"""
+        return {
+            'frames': self.frames,
+            'bytes_in': self.bytes_in,
+            'garbage_bytes': self.garbage_bytes,
+            'resyncs': self.resyncs,
+            'checksum_failures': self.checksum_failures
+        }
+    
+    def _discard(self, count: int):
+        if count <= 0:
+            return
+        self.garbage_bytes += count
+        if self._in_sync:
+            self.resyncs += 1
+            self._in_sync = False
+
+
 class LatencyMeasurement:
     """
     Helper class for precise latency measurements
@@ -20,6 +20,12 @@ from typing import Optional, Tuple, List
 from enum import Enum
 from dataclasses import dataclass
 
+# Checksums run in the C++ extension when it is built (SIMD kernels)
+try:
+    from fast_comms_cpp import PacketValidator as _FastValidator
+except ImportError:
+    _FastValidator = None
+
 
 logger = logging.getLogger(__name__)
 
@@ -261,6 +267,9 @@ class PacketBuilder:
     @staticmethod
     def calculate_checksum(data: bytes) -> int:
         """Calculate IP/TCP checksum"""
+        if _FastValidator is not None:
+            return _FastValidator.calculate_simple_checksum(data)
+        
         checksum = 0
         for i in range(0, len(data), 2):
             if i + 1 < len(data):
@@ -269,9 +278,36 @@ class PacketBuilder:
                 word = data[i] << 8
             checksum += word
             
-        checksum = (checksum >> 16) + (checksum & 0xFFFF)
+        while checksum >> 16:
+            checksum = (checksum >> 16) + (checksum & 0xFFFF)
         checksum = ~checksum & 0xFFFF
         return checksum
+    
+    @staticmethod
+    def update_checksum(checksum: int, old_field: bytes, new_field: bytes) -> int:
+        """
+        Update a checksum after a header field changed (RFC 1624),
+        e.g. a TTL decrement or address rewrite, without resumming the packet
+        
+        The field must start at an even offset in the checksummed data
+        """
+        if len(old_field) != len(new_field):
+            raise ValueError("old_field and new_field must have the same length")
+        if _FastValidator is not None:
+            return _FastValidator.update_checksum(checksum, old_field, new_field)
+        
+        # HC' = ~(~HC + ~m + m')
+        total = ~checksum & 0xFFFF
+        for i in range(0, len(old_field), 2):
+            old_word = old_field[i] << 8
+            new_word = new_field[i] << 8
+            if i + 1 < len(old_field):
+                old_word |= old_field[i + 1]
+                new_word |= new_field[i + 1]
+            total += (~old_word & 0xFFFF) + new_word
+        while total >> 16:
+            total = (total >> 16) + (total & 0xFFFF)
+        return ~total & 0xFFFF
 
 
 def list_available_interfaces() -> List[str]: